@@ -1,19 +1,48 @@
 #include "app/App.h"
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <filesystem>
 #include "systems/Display.h"
+#include "systems/Log.h"
+#include "systems/Profiler.h"
 
-App::App() : m_window(sf::VideoMode({1200u, 800u}), "DofusLike - Sistema de Turnos"),
-             m_player(sf::Vector2i(7, 7), EntityType::Player),
-             m_enemy(sf::Vector2i(10, 10), EntityType::Enemy),
+// Colores de las capas de resaltado
+static const sf::Color REACHABLE_COLOR(0, 255, 255, 100);
+static const sf::Color PATH_PREVIEW_COLOR(255, 255, 255, 110);
+
+// Texturas de los grupos de precarga de las vistas, según el manifiesto
+static std::vector<AssetManifest::Texture> loadPreloadTextures() {
+    AssetManifest manifest;
+    manifest.loadFromFile(AssetManifest::DEFAULT_PATH);
+    return manifest.collectGroups(EntityView::getPreloadGroups());
+}
+
+App::App(const FrameSettings& frameSettings) : m_window(sf::VideoMode({1200u, 800u}), "DofusLike - Sistema de Turnos"),
+             m_player(m_units, m_units.create(sf::Vector2i(7, 7), EntityType::Player)),
+             m_enemy(m_units, m_units.create(sf::Vector2i(10, 10), EntityType::Enemy)),
+             m_mapView(m_map),
+             m_spriteAtlas(loadPreloadTextures(), EntityView::getAtlasFrameHeight(Display::getDesktopScale()), true, &m_workers),
+             m_playerView(m_player, m_spriteAtlas),
+             m_enemyView(m_enemy, m_spriteAtlas),
+             m_overlays(m_map),
+             m_frameSettings(frameSettings),
              m_isTargeting(false),
              m_currentTargetCell(-1, -1),
              m_activeSpellIndex(0),
              m_activeSpell(nullptr),
              m_currentMapFile("data/map01.json") {
     
+    applyFrameSettings();
+    m_mapView.setWorkerPool(&m_workers);
+    Assets::setWorkerPool(&m_workers);
+    
     // Configurar sistema de turnos
-    m_turnSystem.addEntity(&m_player);
-    m_turnSystem.addEntity(&m_enemy);
+    m_turnSystem.addEntity(m_player);
+    m_turnSystem.addEntity(m_enemy);
+    // IA por búsqueda, pensando en otro hilo para no congelar los frames del
+    // turno enemigo
+    m_turnSystem.setEnemyAI(EnemyAI::Search);
+    m_turnSystem.setAsyncAI(true);
     m_turnSystem.startGame();
     
     // Inicializar hechizo activo
@@ -23,130 +52,288 @@ App::App() : m_window(sf::VideoMode({1200u, 800u}), "DofusLike - Sistema de Turn
     m_hud.setWindowSize(m_window.getSize());
     m_hud.setVirtualScale(calculateVirtualScale());
     Display::applyLetterbox(m_window);
-    Display::centerMapInView(m_map);
+    Display::centerMapInView(m_mapView);
     
     // Cargar mapa inicial
     loadMapFromFile(m_currentMapFile);
     
+    // Registrar la partida para poder reproducirla con DofusHeadless
+    startRecording("replays/last.dlrp");
+    
+    // Recarga en caliente de sprites y mapas mientras se edita el contenido
+    if (m_fileWatcher.watch("assets") && m_fileWatcher.watch("data")) {
+        LOG_INFO(App, "Vigilando assets/ y data/ para recarga en caliente");
+    }
+    
     updateReachableTiles();
     updateWindowTitle();
 }
 
+App::~App() {
+    // Lo simulado tras el último comando también queda verificado
+    m_turnSystem.finishRecording(m_map);
+    // El pool muere con App: Assets no debe seguir usándolo
+    Assets::setWorkerPool(nullptr);
+}
+
 void App::run() {
     while (m_window.isOpen()) {
-        float deltaTime = m_clock.restart().asSeconds();
+        bool animating = isAnimating();
+        if (!animating && !m_needsRedraw) {
+            // Reposo: el proceso duerme en waitEvent hasta que llega input. El
+            // timeout solo despierta el bucle de vez en cuando; el tiempo en
+            // reposo no se simula (no hay nada que avanzar).
+            if (auto ev = m_window.waitEvent(sf::seconds(IDLE_WAKE_SECONDS))) {
+                handleEvent(*ev);
+            }
+            m_clock.restart();
+            if (!m_window.isOpen()) break;
+        }
+        
+        // Tiempo real del frame; la simulación lo consume en ticks fijos en update()
+        float deltaTime = std::min(m_clock.restart().asSeconds(), MAX_FRAME_SECONDS);
+        
+        Profiler::beginFrame();
+        {
+            PROFILE_ZONE("App::handleEvents");
+            handleEvents();
+        }
+        {
+            PROFILE_ZONE("App::update");
+            update(deltaTime);
+        }
         
-        handleEvents();
-        update(deltaTime);
-        render();
+        // El frame en que termina una animación también se dibuja (estado final)
+        if (animating || m_needsRedraw || isAnimating()) {
+            PROFILE_ZONE("App::render");
+            m_stats.onFrame(deltaTime);
+            render();
+            m_needsRedraw = false;
+        }
+        Profiler::endFrame();
     }
 }
 
+bool App::isAnimating() const {
+    // Movimiento, animaciones de combate y el turno de la IA avanzan sin input.
+    // Con el overlay de estadísticas o el del profiler visible se dibuja de
+    // forma continua.
+    // Los chunks del terreno en construcción y los assets que aún se están
+    // cargando también piden otro frame.
+    if (m_showStats || m_showProfiler || !m_turnSystem.isPlayerTurn() || m_mapView.hasPendingBuilds()) return true;
+    if (Assets::hasPendingLoads() || m_spriteAtlas.hasPendingWork() || m_mapReloadsInFlight > 0) return true;
+    const Entity* current = m_turnSystem.getCurrentEntity();
+    return current && (current->isMoving() || current->isPlayingCombatAnimation());
+}
+
 void App::handleEvents() {
     while (auto ev = m_window.pollEvent()) {
-        if (ev->is<sf::Event::Closed>()) {
-            m_window.close();
-        }
+        handleEvent(*ev);
+    }
+}
 
-        if (auto* r = ev->getIf<sf::Event::Resized>()) {
-            m_hud.setWindowSize(sf::Vector2u(r->size.x, r->size.y));
+void App::handleEvent(const sf::Event& event) {
+    // El movimiento del ratón solo redibuja si cambia la loseta bajo el cursor
+    if (!event.is<sf::Event::MouseMoved>()) {
+        m_needsRedraw = true;
+    }
+    
+    if (event.is<sf::Event::Closed>()) {
+        m_window.close();
+    }
+    
+    if (auto* r = event.getIf<sf::Event::Resized>()) {
+        m_hud.setWindowSize(sf::Vector2u(r->size.x, r->size.y));
+        m_hud.setVirtualScale(calculateVirtualScale());
+        Display::applyLetterbox(m_window);
+        Display::centerMapInView(m_mapView);
+    }
+    
+    if (auto kb = event.getIf<sf::Event::KeyPressed>()) {
+        if (kb->code == sf::Keyboard::Key::Enter) {
+            // Tecla Enter: finalizar turno del jugador
+            if (m_turnSystem.isPlayerTurn() && !m_isTargeting) {
+                m_turnSystem.execute(BattleCommand::endTurn(), m_map);
+                updateReachableTiles();
+                updateWindowTitle();
+            }
+        }
+        else if (kb->code == sf::Keyboard::Key::F11) {
+            // Borderless fullscreen toggle (simple: ir a borderless)
+            auto desktop = sf::VideoMode::getDesktopMode();
+            m_window.create(sf::VideoMode({desktop.size.x, desktop.size.y}), "DofusLike - Sistema de Turnos", sf::Style::None);
+            m_hud.setWindowSize(m_window.getSize());
             m_hud.setVirtualScale(calculateVirtualScale());
             Display::applyLetterbox(m_window);
-            Display::centerMapInView(m_map);
+            Display::centerMapInView(m_mapView);
+            applyFrameSettings(); // La ventana nueva no conserva vsync ni límite
         }
-        
-        if (auto kb = ev->getIf<sf::Event::KeyPressed>()) {
-            if (kb->code == sf::Keyboard::Key::Enter) {
-                // Tecla Enter: finalizar turno del jugador
-                if (m_turnSystem.isPlayerTurn() && !m_isTargeting) {
-                    m_turnSystem.endCurrentTurn();
-                    updateReachableTiles();
-                    updateWindowTitle();
-                }
-            }
-            else if (kb->code == sf::Keyboard::Key::F11) {
-                // Borderless fullscreen toggle (simple: ir a borderless)
-                auto desktop = sf::VideoMode::getDesktopMode();
-                m_window.create(sf::VideoMode({desktop.size.x, desktop.size.y}), "DofusLike - Sistema de Turnos", sf::Style::None);
-                m_hud.setWindowSize(m_window.getSize());
-                m_hud.setVirtualScale(calculateVirtualScale());
-                Display::applyLetterbox(m_window);
-                Display::centerMapInView(m_map);
-            }
-            else if (kb->code == sf::Keyboard::Key::Space) {
-                // Tecla Espacio: castear hechizo en modo targeting
-                if (m_turnSystem.isPlayerTurn() && m_isTargeting) {
-                    tryCastSpell(m_currentTargetCell);
-                }
+        else if (kb->code == sf::Keyboard::Key::Space) {
+            // Tecla Espacio: castear hechizo en modo targeting
+            if (m_turnSystem.isPlayerTurn() && m_isTargeting) {
+                tryCastSpell(m_currentTargetCell);
             }
-            else if (kb->code == sf::Keyboard::Key::Num1) {
-                // Tecla 1: seleccionar hechizo "Golpe" y activar targeting
-                if (m_turnSystem.isPlayerTurn() && !m_player.isMoving()) {
-                    selectSpell(0);
-                    if (!m_isTargeting) {
-                        enterTargetingMode();
-                    }
-                }
-            }
-            else if (kb->code == sf::Keyboard::Key::Num2) {
-                // Tecla 2: seleccionar hechizo "Flecha" y activar targeting
-                if (m_turnSystem.isPlayerTurn() && !m_player.isMoving()) {
-                    selectSpell(1);
-                    if (!m_isTargeting) {
-                        enterTargetingMode();
-                    }
+        }
+        else if (kb->code == sf::Keyboard::Key::Num1) {
+            // Tecla 1: seleccionar hechizo "Golpe" y activar targeting
+            if (m_turnSystem.isPlayerTurn() && !m_player.isMoving()) {
+                selectSpell(0);
+                if (!m_isTargeting) {
+                    enterTargetingMode();
                 }
             }
-            else if (kb->code == sf::Keyboard::Key::Num3) {
-                // Tecla 3: seleccionar hechizo "Curar" y activar targeting
-                if (m_turnSystem.isPlayerTurn() && !m_player.isMoving()) {
-                    selectSpell(2);
-                    if (!m_isTargeting) {
-                        enterTargetingMode();
-                    }
+        }
+        else if (kb->code == sf::Keyboard::Key::Num2) {
+            // Tecla 2: seleccionar hechizo "Flecha" y activar targeting
+            if (m_turnSystem.isPlayerTurn() && !m_player.isMoving()) {
+                selectSpell(1);
+                if (!m_isTargeting) {
+                    enterTargetingMode();
                 }
             }
-            else if (kb->code == sf::Keyboard::Key::Escape) {
-                // Tecla Esc: cancelar modo targeting
-                if (m_isTargeting) {
-                    exitTargetingMode();
+        }
+        else if (kb->code == sf::Keyboard::Key::Num3) {
+            // Tecla 3: seleccionar hechizo "Curar" y activar targeting
+            if (m_turnSystem.isPlayerTurn() && !m_player.isMoving()) {
+                selectSpell(2);
+                if (!m_isTargeting) {
+                    enterTargetingMode();
                 }
             }
-            else if (kb->code == sf::Keyboard::Key::F5) {
-                // Tecla F5: recargar mapa
-                reloadMap();
-            }
-            else if (kb->code == sf::Keyboard::Key::F6) {
-                // Tecla F6: guardar mapa actual
-                saveMapToFile("data/map01.saved.json");
-            }
-            else if (kb->code == sf::Keyboard::Key::F8) {
-                // Tecla F8: toggle debug overlay
-                gDebugOverlay = !gDebugOverlay;
-                std::cout << "Debug overlay: " << (gDebugOverlay ? "ON" : "OFF") << std::endl;
+        }
+        else if (kb->code == sf::Keyboard::Key::Escape) {
+            // Tecla Esc: cancelar modo targeting
+            if (m_isTargeting) {
+                exitTargetingMode();
             }
         }
+        else if (kb->code == sf::Keyboard::Key::F5) {
+            // Tecla F5: recargar mapa
+            reloadMap();
+        }
+        else if (kb->code == sf::Keyboard::Key::F6) {
+            // Tecla F6: guardar mapa actual
+            saveMapToFile("data/map01.saved.json");
+        }
+        else if (kb->code == sf::Keyboard::Key::F7) {
+            // Tecla F7: informe de texturas residentes en consola
+            Assets::printResidencyReport();
+        }
+        else if (kb->code == sf::Keyboard::Key::F8) {
+            // Tecla F8: toggle debug overlay
+            gDebugOverlay = !gDebugOverlay;
+            LOG_INFO(App, "Debug overlay: " << (gDebugOverlay ? "ON" : "OFF"));
+        }
+        else if (kb->code == sf::Keyboard::Key::F9) {
+            // Tecla F9: alternar VSync / límite de FPS / sin límite
+            cycleFrameMode();
+        }
+        else if (kb->code == sf::Keyboard::Key::F10) {
+            // Tecla F10: overlay de estadísticas (tick, render, CPU)
+            m_showStats = !m_showStats;
+        }
+        else if (kb->code == sf::Keyboard::Key::F12 && kb->shift) {
+            // Mayús+F12: exportar los últimos frames del profiler (chrome://tracing)
+            Profiler::exportChromeTrace(TRACE_PATH);
+        }
+        else if (kb->code == sf::Keyboard::Key::F12) {
+            // Tecla F12: overlay del profiler (solo registra mientras está visible)
+            m_showProfiler = !m_showProfiler;
+            Profiler::setEnabled(m_showProfiler);
+        }
+        else if (kb->code == sf::Keyboard::Key::Left || kb->code == sf::Keyboard::Key::Right ||
+                 kb->code == sf::Keyboard::Key::Up || kb->code == sf::Keyboard::Key::Down) {
+            // Flechas: desplazar la cámara una loseta (escalada por el zoom)
+            float step = MapView::TILE_SIZE * 2.f * m_camera.getZoom();
+            sf::Vector2f delta(0.f, 0.f);
+            if (kb->code == sf::Keyboard::Key::Left) delta.x = -step;
+            else if (kb->code == sf::Keyboard::Key::Right) delta.x = step;
+            else if (kb->code == sf::Keyboard::Key::Up) delta.y = -step;
+            else delta.y = step;
+            m_camera.pan(delta);
+        }
+        else if (kb->code == sf::Keyboard::Key::Home) {
+            // Tecla Inicio: recentrar la cámara
+            m_camera.reset();
+        }
+    }
+    
+    if (auto mb = event.getIf<sf::Event::MouseButtonPressed>()) {
+        if (mb->button == sf::Mouse::Button::Middle) {
+            // Botón central: arrastrar para desplazar la cámara
+            m_isPanning = true;
+            m_lastPanPixel = mb->position;
+        } else {
+            handlePlayerInput(screenToWorld(mb->position), mb->button);
+        }
+    }
+    
+    if (auto mr = event.getIf<sf::Event::MouseButtonReleased>()) {
+        if (mr->button == sf::Mouse::Button::Middle) {
+            m_isPanning = false;
+        }
+    }
+    
+    if (auto wheel = event.getIf<sf::Event::MouseWheelScrolled>()) {
+        // Rueda: zoom centrado en el cursor
+        if (wheel->wheel == sf::Mouse::Wheel::Vertical && wheel->delta != 0.f) {
+            m_camera.zoomAt(wheel->delta > 0.f ? 1.f / ZOOM_STEP : ZOOM_STEP, screenToWorld(wheel->position));
+        }
+    }
+    
+    if (auto mm = event.getIf<sf::Event::MouseMoved>()) {
+        if (m_isPanning) {
+            m_camera.pan(screenToWorld(m_lastPanPixel) - screenToWorld(mm->position));
+            m_lastPanPixel = mm->position;
+            m_needsRedraw = true;
+        }
         
-        if (auto mb = ev->getIf<sf::Event::MouseButtonPressed>()) {
-            // Convertir coordenadas de píxeles a coords de la view letterbox
-            sf::Vector2f mousePos = m_window.mapPixelToCoords(sf::Vector2i(mb->position.x, mb->position.y));
-            handlePlayerInput(mousePos, mb->button);
+        sf::Vector2f mousePos = screenToWorld(mm->position);
+        if (m_mapView.updateHover(mousePos)) {
+            updatePathPreview();
+            m_needsRedraw = true;
         }
         
-        if (auto mm = ev->getIf<sf::Event::MouseMoved>()) {
-            sf::Vector2f mousePos = m_window.mapPixelToCoords(sf::Vector2i(mm->position.x, mm->position.y));
-            m_map.updateHover(mousePos);
-            
-            // Actualizar targeting si está activo
-            if (m_isTargeting) {
-                updateTargeting(mousePos);
-            }
+        // Actualizar targeting si está activo
+        if (m_isTargeting) {
+            updateTargeting(mousePos);
         }
     }
 }
 
 void App::update(float deltaTime) {
-    m_turnSystem.update(deltaTime, m_map);
+    // La lógica avanza a paso fijo; el tiempo sobrante se acumula para el siguiente frame
+    m_tickAccumulator += deltaTime;
+    int ticks = 0;
+    while (m_tickAccumulator >= TurnSystem::TICK_SECONDS && ticks < MAX_TICKS_PER_FRAME) {
+        m_turnSystem.update(TurnSystem::TICK_SECONDS, m_map);
+        m_tickAccumulator -= TurnSystem::TICK_SECONDS;
+        m_stats.onTick();
+        ++ticks;
+    }
+    if (ticks == MAX_TICKS_PER_FRAME) {
+        m_tickAccumulator = 0.f; // Evitar espiral tras un frame muy largo
+    }
+    
+    // Archivos cambiados en disco: se aplican aquí, entre dos frames
+    pollHotReload();
+    
+    // Carga de assets en segundo plano: subir a la GPU dentro del presupuesto
+    // del frame y cambiar los placeholders en cuanto el atlas está listo
+    if (Assets::processUploads(sf::milliseconds(UPLOAD_BUDGET_MS))) {
+        m_needsRedraw = true;
+    }
+    if (m_spriteAtlas.update()) {
+        m_needsRedraw = true;
+    }
+    if (!m_startupReported && m_spriteAtlas.isReady()) {
+        m_startupReported = true;
+        Assets::printLoadReport(m_startupClock.getElapsedTime());
+    }
+    
+    // Las vistas siguen el estado de la simulación (sprites y animaciones)
+    m_playerView.update(deltaTime);
+    m_enemyView.update(deltaTime);
     
     // Recalcular casillas alcanzables solo cuando sea necesario
     static int lastPlayerPM = -1;
@@ -158,14 +345,18 @@ void App::update(float deltaTime) {
         sf::Vector2i currentPos = m_player.getPosition();
         
         if (currentPM != lastPlayerPM || currentPos != lastPlayerPos) {
-            std::cout << "=== CAMBIO DETECTADO ===" << std::endl;
-            std::cout << "PM cambió: " << lastPlayerPM << " -> " << currentPM << std::endl;
-            std::cout << "Pos cambió: (" << lastPlayerPos.x << "," << lastPlayerPos.y << ") -> (" << currentPos.x << "," << currentPos.y << ")" << std::endl;
+            LOG_DEBUG(App, "=== CAMBIO DETECTADO ===");
+            LOG_DEBUG(App, "PM cambió: " << lastPlayerPM << " -> " << currentPM);
+            LOG_DEBUG(App, "Pos cambió: (" << lastPlayerPos.x << "," << lastPlayerPos.y << ") -> (" << currentPos.x << "," << currentPos.y << ")");
             updateReachableTiles();
             lastPlayerPM = currentPM;
             lastPlayerPos = currentPos;
-            std::cout << "=== FIN CAMBIO ===" << std::endl;
+            LOG_DEBUG(App, "=== FIN CAMBIO ===");
         }
+    }
+    
+    // El título solo se reconstruye cuando cambia el estado que muestra
+    if (ticks > 0 || m_needsRedraw) {
         updateWindowTitle();
     }
     
@@ -176,29 +367,36 @@ void App::update(float deltaTime) {
 void App::render() {
     m_window.clear(sf::Color(50, 50, 50)); // Fondo gris oscuro
     
-    // Dibujo con la view letterbox (mundo + HUD)
-    Display::applyLetterbox(m_window);
+    // Mundo con la vista de la cámara; solo se dibuja lo que cae dentro
+    m_window.setView(m_camera.getView(m_window.getSize()));
+    m_mapView.setVisibleRect(m_camera.getWorldRect());
     
     // Renderizar el mapa
-    m_map.render(m_window);
-    
-    // Renderizar casillas alcanzables solo en turno del jugador
-    if (m_turnSystem.isPlayerTurn() && !m_isTargeting) {
-        renderReachableTiles();
-    }
-    
-    // Renderizar targeting si está activo
-    if (m_isTargeting) {
-        renderTargeting();
+    m_mapView.render(m_window);
+    
+    // Capas de resaltado: alcanzables y camino en turno del jugador, hechizo en targeting
+    bool showMovement = m_turnSystem.isPlayerTurn() && !m_isTargeting;
+    m_overlays.setVisible(OverlayLayer::Reachable, showMovement);
+    m_overlays.setVisible(OverlayLayer::PathPreview, showMovement && !m_player.isMoving());
+    m_overlays.setVisible(OverlayLayer::Castable, m_isTargeting);
+    m_overlays.setVisible(OverlayLayer::AreaOfEffect, m_isTargeting);
+    m_overlays.draw(m_window, m_mapView);
+    
+    // Renderizar entidades interpolando entre el último tick y el siguiente
+    // (el margen cubre el sprite, más alto que su casilla). Todos los sprites
+    // salen del atlas: un draw por página para todas las entidades.
+    {
+        PROFILE_ZONE("EntityView::render");
+        m_entityBatch.clear();
+        if (m_mapView.isTileVisible(m_player.getPosition(), ENTITY_CULL_MARGIN)) {
+            m_playerView.render(m_entityBatch, m_window, m_mapView, m_tickAccumulator);
+        }
+        if (m_mapView.isTileVisible(m_enemy.getPosition(), ENTITY_CULL_MARGIN)) {
+            m_enemyView.render(m_entityBatch, m_window, m_mapView, m_tickAccumulator);
+        }
+        m_entityBatch.draw(m_window, m_spriteAtlas);
     }
     
-    // Renderizar entidades
-    m_player.render(m_window, m_map);
-    m_enemy.render(m_window, m_map);
-    
-    // Renderizar HUD (siempre al final)
-    m_hud.draw(m_window);
-    
     // Debug overlay
     if (gDebugOverlay) {
         // Dibujar '+' en la posición de cada unidad
@@ -208,21 +406,21 @@ void App::render() {
         crossV.setFillColor(sf::Color::Yellow);
         
         // Player
-        sf::Vector2f playerPos = m_map.getTileCenter(m_player.getPosition().x, m_player.getPosition().y);
+        sf::Vector2f playerPos = m_mapView.getTileCenter(m_player.getPosition().x, m_player.getPosition().y);
         crossH.setPosition({playerPos.x - 5, playerPos.y - 1});
         crossV.setPosition({playerPos.x - 1, playerPos.y - 5});
         m_window.draw(crossH);
         m_window.draw(crossV);
         
         // Enemy
-        sf::Vector2f enemyPos = m_map.getTileCenter(m_enemy.getPosition().x, m_enemy.getPosition().y);
+        sf::Vector2f enemyPos = m_mapView.getTileCenter(m_enemy.getPosition().x, m_enemy.getPosition().y);
         crossH.setPosition({enemyPos.x - 5, enemyPos.y - 1});
         crossV.setPosition({enemyPos.x - 1, enemyPos.y - 5});
         m_window.draw(crossH);
         m_window.draw(crossV);
         
         // Dibujar bounds del sprite del player
-        sf::FloatRect bounds = m_player.getGlobalBounds();
+        sf::FloatRect bounds = m_playerView.getGlobalBounds();
         sf::RectangleShape boundsRect(sf::Vector2f(bounds.size.x, bounds.size.y));
         boundsRect.setPosition({bounds.position.x, bounds.position.y});
         boundsRect.setFillColor(sf::Color::Transparent);
@@ -231,31 +429,65 @@ void App::render() {
         m_window.draw(boundsRect);
     }
     
+    // Renderizar HUD (siempre al final, con la view letterbox fija)
+    Display::applyLetterbox(m_window);
+    m_hud.draw(m_window);
+    
+    // Overlay de estadísticas en píxeles de ventana (fuera del letterbox)
+    if (m_showStats) {
+        sf::Vector2u size = m_window.getSize();
+        m_window.setView(sf::View(sf::FloatRect({0.f, 0.f}, {static_cast<float>(size.x), static_cast<float>(size.y)})));
+        m_stats.draw(m_window);
+    }
+    if (m_showProfiler) {
+        sf::Vector2u size = m_window.getSize();
+        m_window.setView(sf::View(sf::FloatRect({0.f, 0.f}, {static_cast<float>(size.x), static_cast<float>(size.y)})));
+        m_profilerOverlay.draw(m_window, {static_cast<float>(size.x) - 488.f, 8.f});
+    }
+    
     m_window.display();
 }
 
 void App::updateReachableTiles() {
     if (m_turnSystem.isPlayerTurn()) {
-        std::cout << "=== RECALCULANDO CELDAS ALCANZABLES ===" << std::endl;
-        std::cout << "Posición del jugador: (" << m_player.getPosition().x << "," << m_player.getPosition().y << ")" << std::endl;
-        std::cout << "PM restantes: " << m_player.getRemainingPM() << std::endl;
-        m_reachableTiles = m_player.getReachableTiles(m_map);
-        std::cout << "Celdas alcanzables: " << m_reachableTiles.size() << std::endl;
-        std::cout << "=== FIN RECÁLCULO ===" << std::endl;
+        LOG_DEBUG(App, "=== RECALCULANDO CELDAS ALCANZABLES ===");
+        LOG_DEBUG(App, "Posición del jugador: (" << m_player.getPosition().x << "," << m_player.getPosition().y << ")");
+        LOG_DEBUG(App, "PM restantes: " << m_player.getRemainingPM());
+        m_overlays.setTiles(OverlayLayer::Reachable, m_player.getReachableTiles(m_map), REACHABLE_COLOR);
+        LOG_DEBUG(App, "Celdas alcanzables: " << m_overlays.getTiles(OverlayLayer::Reachable).size());
+        LOG_DEBUG(App, "=== FIN RECÁLCULO ===");
+        updatePathPreview();
     }
 }
 
-void App::renderReachableTiles() {
-    for (const auto& tile : m_reachableTiles) {
-        sf::Vector2f screenPos = m_map.getTileTopLeft(tile.x, tile.y);
-        
-        auto diamond = Isometric::createDiamond(sf::Vector2f(Map::TILE_SIZE, Map::TILE_SIZE), sf::Color(0, 255, 255, 100));
-        diamond.setPosition(screenPos);
-        m_window.draw(diamond);
+void App::updatePathPreview() {
+    sf::Vector2i hovered = m_mapView.getHoveredTile();
+    if (!m_turnSystem.isPlayerTurn() || m_isTargeting || m_player.isMoving() ||
+        hovered == m_player.getPosition() || !m_overlays.contains(OverlayLayer::Reachable, hovered)) {
+        m_overlays.clear(OverlayLayer::PathPreview);
+        return;
+    }
+    
+    // Mismo recorte que Entity::moveTo: sin la casilla inicial y limitado a los PM
+    std::vector<sf::Vector2i> path = Pathfinding::findPath(m_map, m_player.getPosition(), hovered);
+    if (!path.empty() && path.front() == m_player.getPosition()) {
+        path.erase(path.begin());
+    }
+    if (static_cast<int>(path.size()) > m_player.getRemainingPM()) {
+        path.resize(m_player.getRemainingPM());
     }
+    m_overlays.setTiles(OverlayLayer::PathPreview, path, PATH_PREVIEW_COLOR);
 }
 
 void App::updateWindowTitle() {
+    // Clave barata del estado mostrado: evita rehacer el string y llamar a setTitle
+    const std::array<int, 7> titleKey = {
+        m_turnSystem.isPlayerTurn() ? 1 : 0, m_player.getRemainingPA(), m_player.getRemainingPM(),
+        m_player.getHP(), m_enemy.getHP(), m_activeSpellIndex, m_activeSpell ? 1 : 0
+    };
+    if (titleKey == m_lastTitleKey) return;
+    m_lastTitleKey = titleKey;
+    
     std::string turnStr = m_turnSystem.isPlayerTurn() ? "Player" : "Enemy";
     std::string title = "Turno: " + turnStr + 
                        " | PA: " + std::to_string(m_player.getRemainingPA()) + 
@@ -271,12 +503,41 @@ void App::updateWindowTitle() {
     m_window.setTitle(title);
 }
 
+void App::applyFrameSettings() {
+    m_window.setVerticalSyncEnabled(m_frameSettings.mode == FrameMode::VSync);
+    m_window.setFramerateLimit(m_frameSettings.mode == FrameMode::Limited ? m_frameSettings.fpsLimit : 0);
+    m_stats.setFrameModeLabel(getFrameModeLabel());
+    LOG_INFO(App, "Modo de frame: " << getFrameModeLabel());
+}
+
+void App::cycleFrameMode() {
+    switch (m_frameSettings.mode) {
+        case FrameMode::VSync: m_frameSettings.mode = FrameMode::Limited; break;
+        case FrameMode::Limited: m_frameSettings.mode = FrameMode::Unlimited; break;
+        case FrameMode::Unlimited: m_frameSettings.mode = FrameMode::VSync; break;
+    }
+    applyFrameSettings();
+}
+
+std::string App::getFrameModeLabel() const {
+    switch (m_frameSettings.mode) {
+        case FrameMode::VSync: return "VSYNC";
+        case FrameMode::Limited: return "LIMITE " + std::to_string(m_frameSettings.fpsLimit);
+        case FrameMode::Unlimited: return "SIN LIMITE";
+    }
+    return "";
+}
+
 void App::handlePlayerInput(sf::Vector2f mousePos, sf::Mouse::Button button) {
     if (!m_turnSystem.isPlayerTurn()) return;
     
+    // Solo se puede interactuar con losetas visibles en pantalla
+    sf::Vector2i clickedTile = m_mapView.getTileFromPosition(mousePos);
+    if (!m_mapView.isTileVisible(clickedTile)) return;
+    
     if (button == sf::Mouse::Button::Right) {
         // Clic derecho: alternar loseta
-        m_map.handleMouseClick(mousePos, sf::Mouse::Button::Right);
+        m_turnSystem.execute(BattleCommand::toggleTile(clickedTile), m_map);
         updateReachableTiles();
     }
     else if (button == sf::Mouse::Button::Left) {
@@ -286,13 +547,13 @@ void App::handlePlayerInput(sf::Vector2f mousePos, sf::Mouse::Button button) {
         } else {
             // Clic izquierdo: mover jugador si la casilla es alcanzable y no está moviéndose
             if (!m_player.isMoving()) {
-                sf::Vector2i targetTile = m_map.getTileFromPosition(mousePos);
+                sf::Vector2i targetTile = clickedTile;
                 
                 // Verificar si la casilla es alcanzable
-                bool isReachable = std::find(m_reachableTiles.begin(), m_reachableTiles.end(), targetTile) != m_reachableTiles.end();
+                bool isReachable = m_overlays.contains(OverlayLayer::Reachable, targetTile);
                 
                 if (isReachable && targetTile != m_player.getPosition()) {
-                    m_player.moveTo(targetTile, m_map);
+                    m_turnSystem.execute(BattleCommand::move(targetTile), m_map);
                 }
             }
         }
@@ -302,97 +563,76 @@ void App::handlePlayerInput(sf::Vector2f mousePos, sf::Mouse::Button button) {
 void App::enterTargetingMode() {
     if (m_turnSystem.isPlayerTurn() && !m_player.isMoving() && m_activeSpell) {
         m_isTargeting = true;
-        m_castableCells = m_player.getCastableCells(*m_activeSpell, m_map);
-        std::cout << "Modo targeting activado para " << m_activeSpell->name << ". Celdas válidas: " << m_castableCells.size() << std::endl;
+        m_overlays.clear(OverlayLayer::PathPreview);
+        updateSpellTargeting();
     }
 }
 
 void App::exitTargetingMode() {
     m_isTargeting = false;
     m_currentTargetCell = sf::Vector2i(-1, -1);
-    m_castableCells.clear();
-    std::cout << "Modo targeting desactivado." << std::endl;
+    m_overlays.clear(OverlayLayer::Castable);
+    m_overlays.clear(OverlayLayer::AreaOfEffect);
+    updatePathPreview();
+    LOG_DEBUG(App, "Modo targeting desactivado.");
 }
 
 void App::updateTargeting(sf::Vector2f mousePos) {
     if (!m_isTargeting) return;
     
-    sf::Vector2i targetCell = m_map.getTileFromPosition(mousePos);
-    m_currentTargetCell = targetCell;
+    sf::Vector2i targetCell = m_mapView.getTileFromPosition(mousePos);
+    if (targetCell != m_currentTargetCell) {
+        m_currentTargetCell = targetCell;
+        updateAreaOfEffect();
+        m_needsRedraw = true;
+    }
 }
 
-void App::renderTargeting() {
-    if (!m_activeSpell) return;
-    
-    // Renderizar celdas casteables con el color del hechizo
-    sf::Color spellColor = m_activeSpell->color;
-    spellColor.a = 150; // Hacer semi-transparente
-    
-    for (const auto& cell : m_castableCells) {
-        sf::Vector2f screenPos = m_map.getTileTopLeft(cell.x, cell.y);
-        
-        auto diamond = Isometric::createDiamond(sf::Vector2f(Map::TILE_SIZE, Map::TILE_SIZE), spellColor);
-        diamond.setPosition(screenPos);
-        m_window.draw(diamond);
+void App::updateAreaOfEffect() {
+    // Los hechizos actuales afectan a una sola celda: la zona es la celda apuntada
+    if (!m_isTargeting || !m_activeSpell || !m_overlays.contains(OverlayLayer::Castable, m_currentTargetCell)) {
+        m_overlays.clear(OverlayLayer::AreaOfEffect);
+        return;
     }
     
-    // Renderizar celda objetivo actual si es válida
-    if (m_currentTargetCell.x >= 0 && m_currentTargetCell.y >= 0) {
-        bool isValidTarget = std::find(m_castableCells.begin(), m_castableCells.end(), m_currentTargetCell) != m_castableCells.end();
-        
-        if (isValidTarget) {
-            sf::Vector2f screenPos = m_map.getTileTopLeft(m_currentTargetCell.x, m_currentTargetCell.y);
-            
-            // Color más brillante para la celda objetivo
-            sf::Color targetColor = m_activeSpell->color;
-            targetColor.a = 200;
-            auto diamond = Isometric::createDiamond(sf::Vector2f(Map::TILE_SIZE, Map::TILE_SIZE), targetColor);
-            diamond.setPosition(screenPos);
-            m_window.draw(diamond);
-        }
-    }
+    // Color más brillante para la celda objetivo
+    sf::Color targetColor(m_activeSpell->color);
+    targetColor.a = 200;
+    m_overlays.setTiles(OverlayLayer::AreaOfEffect, {m_currentTargetCell}, targetColor);
 }
 
 void App::tryCastSpell(sf::Vector2i targetCell) {
     if (!m_isTargeting || !m_turnSystem.isPlayerTurn() || !m_activeSpell) {
-        std::cout << "No se puede castear: targeting=" << m_isTargeting << ", playerTurn=" << m_turnSystem.isPlayerTurn() << ", activeSpell=" << (m_activeSpell ? m_activeSpell->name : "null") << std::endl;
+        LOG_DEBUG(App, "No se puede castear: targeting=" << m_isTargeting << ", playerTurn=" << m_turnSystem.isPlayerTurn() << ", activeSpell=" << (m_activeSpell ? m_activeSpell->name : "null"));
         return;
     }
     
-    std::cout << "=== INTENTANDO CASTEAR " << m_activeSpell->name << " ===" << std::endl;
-    std::cout << "Target cell: (" << targetCell.x << "," << targetCell.y << ")" << std::endl;
-    std::cout << "Enemy position: (" << m_enemy.getPosition().x << "," << m_enemy.getPosition().y << ")" << std::endl;
-    std::cout << "Player PA: " << m_player.getRemainingPA() << std::endl;
+    LOG_DEBUG(App, "=== INTENTANDO CASTEAR " << m_activeSpell->name << " ===");
+    LOG_DEBUG(App, "Target cell: (" << targetCell.x << "," << targetCell.y << ")");
+    LOG_DEBUG(App, "Enemy position: (" << m_enemy.getPosition().x << "," << m_enemy.getPosition().y << ")");
+    LOG_DEBUG(App, "Player PA: " << m_player.getRemainingPA());
     
     // Verificar si la celda es válida para castear
-    bool isValidTarget = std::find(m_castableCells.begin(), m_castableCells.end(), targetCell) != m_castableCells.end();
-    std::cout << "isValidTarget (en lista): " << isValidTarget << std::endl;
+    bool isValidTarget = m_overlays.contains(OverlayLayer::Castable, targetCell);
+    LOG_DEBUG(App, "isValidTarget (en lista): " << isValidTarget);
     
     // Verificar si puede castear (incluye PA, rango y LoS)
     bool canCast = m_player.canCastSpell(*m_activeSpell, targetCell, m_map);
-    std::cout << "canCast (verificación completa): " << canCast << std::endl;
+    LOG_DEBUG(App, "canCast (verificación completa): " << canCast);
     
     if (canCast) {
         // Verificar si hay un enemigo en la celda objetivo
         if (m_enemy.getPosition() == targetCell) {
-            std::cout << "*** LANZANDO " << m_activeSpell->name << " AL ENEMIGO ***" << std::endl;
+            LOG_DEBUG(App, "*** LANZANDO " << m_activeSpell->name << " AL ENEMIGO ***");
             
-            // Iniciar animación de combate según el hechizo
-            if (m_activeSpell->name == "Golpe") {
-                m_player.startCombatAnimation(0); // ataqueespadaa.png
-            } else if (m_activeSpell->name == "Flecha") {
-                m_player.startCombatAnimation(1); // ataquearco.png
-            } else if (m_activeSpell->name == "Curar") {
-                m_player.startCombatAnimation(2); // heal.png
-            }
-            
-            bool success = m_player.castSpell(*m_activeSpell, targetCell, m_map, m_enemy);
+            // TurnSystem lanza la animación de combate del hechizo y aplica el efecto
+            bool success = m_turnSystem.execute(BattleCommand::castSpell(m_activeSpellIndex, targetCell), m_map);
             if (success) {
-                std::cout << "Hechizo lanzado exitosamente!" << std::endl;
+                LOG_DEBUG(App, "Hechizo lanzado exitosamente!");
             }
         } else {
-            std::cout << "*** NO HAY OBJETIVO EN LA CELDA ***" << std::endl;
-            std::cout << "No se puede lanzar " << m_activeSpell->name << " sin objetivo" << std::endl;
+            LOG_DEBUG(App, "*** NO HAY OBJETIVO EN LA CELDA ***");
+            LOG_DEBUG(App, "No se puede lanzar " << m_activeSpell->name << " sin objetivo");
         }
         
         updateWindowTitle();
@@ -402,12 +642,12 @@ void App::tryCastSpell(sf::Vector2i targetCell) {
             exitTargetingMode();
         }
     } else {
-        std::cout << "*** NO SE PUEDE CASTEAR ***" << std::endl;
+        LOG_DEBUG(App, "*** NO SE PUEDE CASTEAR ***");
         if (!isValidTarget) {
-            std::cout << "Razón: Celda no está en la lista de válidas" << std::endl;
+            LOG_DEBUG(App, "Razón: Celda no está en la lista de válidas");
         }
     }
-    std::cout << "=== FIN INTENTO CASTEO ===" << std::endl;
+    LOG_DEBUG(App, "=== FIN INTENTO CASTEO ===");
 }
 
 // Métodos del sistema de hechizos
@@ -416,29 +656,28 @@ void App::selectSpell(int spellIndex) {
     if (spellIndex >= 0 && spellIndex < static_cast<int>(spells.size())) {
         m_activeSpellIndex = spellIndex;
         m_activeSpell = &spells[spellIndex];
-        std::cout << "Hechizo seleccionado: " << m_activeSpell->name << " (PA: " << m_activeSpell->costPA << ")" << std::endl;
+        LOG_INFO(App, "Hechizo seleccionado: " << m_activeSpell->name << " (PA: " << m_activeSpell->costPA << ")");
         
         // Si estamos en modo targeting, actualizar las celdas casteables
         if (m_isTargeting) {
             updateSpellTargeting();
         }
     } else {
-        std::cout << "Índice de hechizo inválido: " << spellIndex << std::endl;
+        LOG_WARN(App, "Índice de hechizo inválido: " << spellIndex);
     }
 }
 
 void App::updateSpellTargeting() {
     if (m_activeSpell && m_turnSystem.isPlayerTurn()) {
-        m_castableCells = m_player.getCastableCells(*m_activeSpell, m_map);
-        std::cout << "Celdas casteables actualizadas para " << m_activeSpell->name << ": " << m_castableCells.size() << std::endl;
+        // Celdas casteables con el color del hechizo, semi-transparente
+        sf::Color spellColor(m_activeSpell->color);
+        spellColor.a = 150;
+        m_overlays.setTiles(OverlayLayer::Castable, m_player.getCastableCells(*m_activeSpell, m_map), spellColor);
+        updateAreaOfEffect();
+        LOG_DEBUG(App, "Celdas casteables actualizadas para " << m_activeSpell->name << ": " << m_overlays.getTiles(OverlayLayer::Castable).size());
     }
 }
 
-void App::renderSpellTargeting() {
-    // Este método se llama desde render() cuando estamos en modo targeting
-    renderTargeting();
-}
-
 void App::updateHUD() {
     // Actualizar estadísticas del jugador
     m_hud.setPlayerStats(
@@ -473,21 +712,28 @@ void App::updateHUD() {
 void App::loadMapFromFile(const std::string& path) {
     MapData mapData;
     if (JsonParser::loadMapFromFile(path, mapData)) {
-        if (m_map.loadFromArray(mapData.width, mapData.height, mapData.blocked)) {
-            std::cout << "Mapa cargado exitosamente desde: " << path << std::endl;
-            m_currentMapFile = path;
-            
-            // Recalcular todo después de cargar el mapa
-            updateReachableTiles();
-            if (m_isTargeting) {
-                updateSpellTargeting();
-            }
-        } else {
-            std::cout << "Error: No se pudo cargar el mapa en la estructura interna" << std::endl;
+        applyMapData(path, mapData);
+    } else {
+        LOG_ERROR(App, "No se pudo cargar el archivo de mapa: " << path);
+        LOG_WARN(App, "Usando mapa por defecto (15x15 sin bloqueos)");
+    }
+}
+
+void App::applyMapData(const std::string& path, const MapData& mapData) {
+    if (m_map.loadFromArray(mapData.width, mapData.height, mapData.blocked)) {
+        LOG_INFO(App, "Mapa cargado exitosamente desde: " << path);
+        m_currentMapFile = path;
+        Display::centerMapInView(m_mapView); // El tamaño puede haber cambiado
+        m_recorder.recordMap(m_turnSystem.getTick(), m_map.getWidth(), m_map.getHeight(), m_map.exportBlockedLinear());
+        
+        // Recalcular todo después de cargar el mapa
+        updateReachableTiles();
+        if (m_isTargeting) {
+            updateSpellTargeting();
         }
+        m_needsRedraw = true;
     } else {
-        std::cout << "Error: No se pudo cargar el archivo de mapa: " << path << std::endl;
-        std::cout << "Usando mapa por defecto (15x15 sin bloqueos)" << std::endl;
+        LOG_ERROR(App, "No se pudo cargar el mapa en la estructura interna");
     }
 }
 
@@ -499,16 +745,86 @@ void App::saveMapToFile(const std::string& path) {
     mapData.valid = true;
     
     if (JsonParser::saveMapToFile(path, mapData)) {
-        std::cout << "Mapa guardado exitosamente en: " << path << std::endl;
+        LOG_INFO(App, "Mapa guardado exitosamente en: " << path);
     } else {
-        std::cout << "Error: No se pudo guardar el mapa en: " << path << std::endl;
+        LOG_ERROR(App, "No se pudo guardar el mapa en: " << path);
     }
 }
 
 void App::reloadMap() {
-    std::cout << "=== RECARGANDO MAPA ===" << std::endl;
+    LOG_DEBUG(App, "=== RECARGANDO MAPA ===");
     loadMapFromFile(m_currentMapFile);
-    std::cout << "=== FIN RECARGA ===" << std::endl;
+    LOG_DEBUG(App, "=== FIN RECARGA ===");
+}
+
+void App::pollHotReload() {
+    std::vector<std::string> changed;
+    m_fileWatcher.poll(changed);
+    
+    const std::string currentMap = std::filesystem::path(m_currentMapFile).lexically_normal().generic_string();
+    for (const auto& path : changed) {
+        if (path == currentMap) {
+            // Parsear en el pool; el mapa se sustituye entero al recoger el resultado
+            m_mapReloadsInFlight++;
+            m_workers.submit([pending = m_pendingMapReloads, path]() {
+                MapReload reload;
+                reload.path = path;
+                reload.ok = JsonParser::loadMapFromFile(path, reload.data);
+                std::lock_guard<std::mutex> lock(pending->mutex);
+                pending->results.push_back(std::move(reload));
+            });
+        } else if (path == AssetManifest::DEFAULT_PATH) {
+            LOG_INFO(App, "El manifiesto de assets cambió; reinicia para aplicar grupos y rejillas nuevos");
+        } else {
+            // Una textura puede estar en el atlas, en la caché de Assets o en ambos
+            const bool inAtlas = m_spriteAtlas.reloadSheet(path);
+            const bool inAssets = Assets::reloadTexture(path);
+            if (inAtlas || inAssets) {
+                LOG_INFO(App, "Recargando " << path);
+            }
+        }
+    }
+    
+    if (m_mapReloadsInFlight == 0) return;
+    std::vector<MapReload> reloads;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMapReloads->mutex);
+        reloads.swap(m_pendingMapReloads->results);
+    }
+    for (const auto& reload : reloads) {
+        m_mapReloadsInFlight--;
+        // Solo importa la versión más reciente del mapa actual
+        if (&reload != &reloads.back()) continue;
+        if (!reload.ok) {
+            LOG_WARN(App, reload.path << " no es válido; se mantiene el mapa actual");
+            continue;
+        }
+        LOG_INFO(App, "Mapa " << reload.path << " cambió");
+        applyMapData(reload.path, reload.data);
+    }
+}
+
+void App::startRecording(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    
+    // Mismo orden de alta que en el constructor
+    std::vector<ReplayEntity> entities = {
+        {static_cast<uint8_t>(m_player.getType()), m_player.getPosition(), m_turnSystem.getTeam(0), m_turnSystem.getInitiative(0)},
+        {static_cast<uint8_t>(m_enemy.getType()), m_enemy.getPosition(), m_turnSystem.getTeam(1), m_turnSystem.getInitiative(1)}
+    };
+    // Con una IA que depende del reloj sus comandos se graban también
+    uint8_t flags = m_turnSystem.getEnemyAI() != EnemyAI::Greedy ? ReplayRecorder::FLAG_ENEMY_COMMANDS : 0;
+    if (m_recorder.open(path, entities, flags)) {
+        m_recorder.recordMap(m_turnSystem.getTick(), m_map.getWidth(), m_map.getHeight(), m_map.exportBlockedLinear());
+        m_turnSystem.setRecorder(&m_recorder);
+        LOG_INFO(App, "Grabando repetición en: " << path);
+    }
+}
+
+sf::Vector2f App::screenToWorld(sf::Vector2i pixel) const {
+    // Siempre con la vista de la cámara (la vista activa puede ser la del HUD)
+    return m_window.mapPixelToCoords(pixel, m_camera.getView(m_window.getSize()));
 }
 
 float App::calculateVirtualScale() const {
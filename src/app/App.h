@@ -1,37 +1,105 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
+#include <array>
 #include "map/Map.h"
 #include "units/Entity.h"
+#include "view/MapView.h"
+#include "view/EntityView.h"
+#include "view/MapOverlays.h"
+#include "view/Camera.h"
+#include "view/StatsOverlay.h"
+#include "view/ProfilerOverlay.h"
+#include "view/SpriteAtlas.h"
 #include "systems/TurnSystem.h"
 #include "systems/Pathfinding.h"
 #include "systems/LineOfSight.h"
 #include "systems/Spells.h"
 #include "systems/HUD.h"
 #include "systems/Json.hpp"
+#include "systems/ThreadPool.h"
+#include "systems/FileWatcher.h"
+#include <memory>
+#include <mutex>
+
+// Control del ritmo de render (la simulación siempre avanza a TICK_SECONDS)
+enum class FrameMode {
+    VSync,      // Sincronizado con el monitor
+    Limited,    // setFramerateLimit(fpsLimit)
+    Unlimited   // Sin límite (benchmark; ocupa un núcleo)
+};
+
+struct FrameSettings {
+    FrameMode mode = FrameMode::Limited;
+    unsigned int fpsLimit = 120;
+};
 
 class App {
 public:
-    App();
+    explicit App(const FrameSettings& frameSettings = FrameSettings());
+    ~App();
     void run();
     
 private:
     void handleEvents();
+    void handleEvent(const sf::Event& event);
+    bool isAnimating() const;
     void update(float deltaTime);
     void render();
     
+    // Primer miembro: mide el arranque completo (ventana, mapa y assets)
+    sf::Clock m_startupClock;
+    bool m_startupReported = false;
+    
     sf::RenderWindow m_window;
     Map m_map;
     TurnSystem m_turnSystem;
+    EntityStore m_units;
     Entity m_player;
     Entity m_enemy;
-    std::vector<sf::Vector2i> m_reachableTiles;
+    
+    // Hilos de trabajo de la capa de vista (construcción de chunks del terreno)
+    ThreadPool m_workers;
+    
+    // Capa de vista (solo lee el estado de simulación)
+    MapView m_mapView;
+    SpriteAtlas m_spriteAtlas;
+    SpriteBatch m_entityBatch;
+    EntityView m_playerView;
+    EntityView m_enemyView;
+    MapOverlays m_overlays;
+    
+    // Cámara del mundo (rueda: zoom, botón central/flechas: desplazar, Inicio: recentrar)
+    Camera m_camera;
+    bool m_isPanning = false;
+    sf::Vector2i m_lastPanPixel;
+    static constexpr float ZOOM_STEP = 1.1f;
+    static constexpr int ENTITY_CULL_MARGIN = 6;
+    
     sf::Clock m_clock;
+    float m_tickAccumulator = 0.f;
+    static constexpr int MAX_TICKS_PER_FRAME = 8;
+    static constexpr float MAX_FRAME_SECONDS = 0.25f;
+    
+    // Ritmo de render y overlay de estadísticas (F9 / F10)
+    FrameSettings m_frameSettings;
+    StatsOverlay m_stats;
+    bool m_showStats = false;
+    
+    // Profiler de frames: overlay con F12, Mayús+F12 exporta la traza
+    ProfilerOverlay m_profilerOverlay;
+    bool m_showProfiler = false;
+    static constexpr const char* TRACE_PATH = "profiles/trace.json";
+    
+    // Render bajo demanda: solo se redibuja si algo cambió o hay animaciones
+    bool m_needsRedraw = true;
+    static constexpr float IDLE_WAKE_SECONDS = 0.5f;
+    static constexpr int UPLOAD_BUDGET_MS = 4;  // Subida de texturas por frame
+    std::array<int, 7> m_lastTitleKey = {-1, -1, -1, -1, -1, -1, -1};
     
     // Sistema de targeting
     bool m_isTargeting;
     sf::Vector2i m_currentTargetCell;
-    std::vector<sf::Vector2i> m_castableCells;
     
     // Sistema de hechizos
     int m_activeSpellIndex;
@@ -43,34 +111,58 @@ private:
     // Sistema de mapas
     std::string m_currentMapFile;
     
+    // Log de repetición (replays/last.dlrp)
+    ReplayRecorder m_recorder;
+    
+    // Recarga en caliente: cambios en assets/ y data/ se decodifican en el
+    // pool y se aplican al principio de un frame
+    struct MapReload {
+        std::string path;
+        MapData data;
+        bool ok = false;
+    };
+    struct PendingMapReloads {
+        std::mutex mutex;
+        std::vector<MapReload> results;
+    };
+    FileWatcher m_fileWatcher;
+    std::shared_ptr<PendingMapReloads> m_pendingMapReloads = std::make_shared<PendingMapReloads>();
+    int m_mapReloadsInFlight = 0;
+    
     // Debug overlay
     bool gDebugOverlay = false;
     
     void updateReachableTiles();
-    void renderReachableTiles();
+    void updatePathPreview();
     void updateWindowTitle();
+    void applyFrameSettings();
+    void cycleFrameMode();
+    std::string getFrameModeLabel() const;
     void handlePlayerInput(sf::Vector2f mousePos, sf::Mouse::Button button);
     
     // Sistema de targeting
     void enterTargetingMode();
     void exitTargetingMode();
     void updateTargeting(sf::Vector2f mousePos);
-    void renderTargeting();
+    void updateAreaOfEffect();
     void tryCastSpell(sf::Vector2i targetCell);
     
     // Sistema de hechizos
     void selectSpell(int spellIndex);
     void updateSpellTargeting();
-    void renderSpellTargeting();
     
     // Sistema de HUD
     void updateHUD();
     
     // Sistema de carga/guardado de mapas
     void loadMapFromFile(const std::string& path);
+    void applyMapData(const std::string& path, const MapData& mapData);
     void saveMapToFile(const std::string& path);
     void reloadMap();
+    void pollHotReload();
+    void startRecording(const std::string& path);
     
     // Sistema responsive
     float calculateVirtualScale() const;
+    sf::Vector2f screenToWorld(sf::Vector2i pixel) const;
 };
@@ -0,0 +1,367 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "map/Map.h"
+#include "systems/AllocTracker.h"
+#include "systems/InfluenceMap.h"
+#include "systems/Json.hpp"
+#include "systems/LineOfSight.h"
+#include "systems/Log.h"
+#include "systems/Pathfinding.h"
+#include "systems/TacticalState.h"
+
+// Microbenchmarks de pathfinding, línea de visión, turnos de la IA y E/S de mapas (sin ventana, sobre DofusCore):
+//   dofus_bench [--filter texto] [--min-time ms] [--json ruta]
+// Cada caso se repite por lotes hasta superar --min-time e informa ns/op,
+// reservas de memoria y bytes por op y ops/s. Con --json el resultado se
+// escribe además como JSON para comparar entre versiones. Las reservas las
+// cuenta AllocTracker (el ejecutable enlaza siempre DofusAllocHook).
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    
+    // Generador xorshift32: mismos mapas y consultas en cualquier plataforma
+    struct Random {
+        uint32_t state;
+        explicit Random(uint32_t seed) : state(seed ? seed : 1) {}
+        uint32_t next() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+        int range(int n) { return static_cast<int>(next() % static_cast<uint32_t>(n)); }
+    };
+    
+    struct BenchMap {
+        std::string name;
+        std::string path;   // Vacío en los generados
+        MapData data;
+        Map map;
+        std::vector<sf::Vector2i> freeCells;
+        std::vector<int> component;  // Región conexa de cada loseta (-1 = bloqueada)
+    };
+    
+    struct Result {
+        std::string name;
+        std::string map;
+        uint64_t iterations = 0;
+        double nsPerOp = 0.0;
+        double allocsPerOp = 0.0;
+        double bytesPerOp = 0.0;
+        double opsPerSecond = 0.0;
+    };
+    
+    // Evita que el compilador elimine las llamadas medidas
+    volatile size_t s_sink = 0;
+    
+    MapData generateMap(int width, int height, int blockedPercent, uint32_t seed) {
+        MapData data;
+        data.width = width;
+        data.height = height;
+        data.blocked.resize(static_cast<size_t>(width) * height);
+        Random random(seed);
+        for (auto& cell : data.blocked) {
+            cell = random.range(100) < blockedPercent ? 1 : 0;
+        }
+        data.valid = true;
+        return data;
+    }
+    
+    bool prepareMap(BenchMap& bench) {
+        if (!bench.map.loadFromArray(bench.data.width, bench.data.height, bench.data.blocked)) {
+            return false;
+        }
+        for (int y = 0; y < bench.data.height; ++y) {
+            for (int x = 0; x < bench.data.width; ++x) {
+                if (!bench.map.isBlocked(x, y)) bench.freeCells.push_back({x, y});
+            }
+        }
+        if (bench.freeCells.empty()) return false;
+        
+        // Regiones conexas (4-vecinos): findPath se mide entre losetas
+        // alcanzables; un par sin camino explora toda su región
+        int width = bench.data.width;
+        bench.component.assign(static_cast<size_t>(width) * bench.data.height, -1);
+        std::vector<sf::Vector2i> stack;
+        int next = 0;
+        for (sf::Vector2i seed : bench.freeCells) {
+            if (bench.component[seed.y * width + seed.x] >= 0) continue;
+            bench.component[seed.y * width + seed.x] = next;
+            stack.push_back(seed);
+            while (!stack.empty()) {
+                sf::Vector2i cell = stack.back();
+                stack.pop_back();
+                const sf::Vector2i offsets[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+                for (sf::Vector2i offset : offsets) {
+                    sf::Vector2i n = cell + offset;
+                    if (!bench.map.isValidPosition(n.x, n.y) || bench.map.isBlocked(n.x, n.y)) continue;
+                    int& label = bench.component[n.y * width + n.x];
+                    if (label < 0) {
+                        label = next;
+                        stack.push_back(n);
+                    }
+                }
+            }
+            next++;
+        }
+        return true;
+    }
+    
+    // Pares de celdas libres fijos por mapa; maxDistance limita la distancia
+    // Manhattan (0 = sin límite) y connected exige que haya camino entre ellas
+    std::vector<std::pair<sf::Vector2i, sf::Vector2i>> makePairs(const BenchMap& bench, size_t count, int maxDistance, bool connected, uint32_t seed) {
+        std::vector<std::pair<sf::Vector2i, sf::Vector2i>> pairs;
+        Random random(seed);
+        const auto& cells = bench.freeCells;
+        for (size_t attempts = 0; pairs.size() < count && attempts < count * 64; ++attempts) {
+            sf::Vector2i a = cells[random.range(static_cast<int>(cells.size()))];
+            sf::Vector2i b = cells[random.range(static_cast<int>(cells.size()))];
+            if (maxDistance > 0 && std::abs(a.x - b.x) + std::abs(a.y - b.y) > maxDistance) continue;
+            int width = bench.data.width;
+            if (connected && bench.component[a.y * width + a.x] != bench.component[b.y * width + b.x]) continue;
+            pairs.push_back({a, b});
+        }
+        if (pairs.empty()) pairs.push_back({cells.front(), cells.front()});
+        return pairs;
+    }
+    
+    // Batallas de 2 contra 2 para las IA: cada par cercano aporta un jugador y
+    // un enemigo, y el siguiente par la otra pareja
+    std::vector<TacticalState> makeTacticalStates(const std::vector<std::pair<sf::Vector2i, sf::Vector2i>>& pairs) {
+        std::vector<TacticalState> states;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            const auto& a = pairs[i];
+            const auto& b = pairs[(i + 1) % pairs.size()];
+            TacticalState state;
+            sf::Vector2i positions[4] = {a.first, a.second, b.first, b.second};
+            for (int u = 0; u < 4; ++u) {
+                bool player = u % 2 == 0;
+                state.units[u] = {positions[u], 100, 3, 6, 3, 6, player ? 0 : 1, player};
+            }
+            state.count = 4;
+            state.setTurnOrder({0, 1, 2, 3});
+            state.hash = TacticalState::computeHash(state);
+            states.push_back(state);
+        }
+        return states;
+    }
+    
+    // Ejecuta op(i) por lotes que se duplican hasta superar minTime
+    Result measure(const std::string& name, const std::string& map, double minTimeSeconds, const std::function<void(size_t)>& op) {
+        op(0);  // Calentamiento (cachés, primeras reservas)
+        
+        uint64_t batch = 1;
+        while (true) {
+            AllocTracker::Counters before = AllocTracker::getThreadCounters();
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < batch; ++i) {
+                op(static_cast<size_t>(i));
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            
+            if (seconds >= minTimeSeconds || batch >= (1ull << 30)) {
+                Result result;
+                result.name = name;
+                result.map = map;
+                result.iterations = batch;
+                result.nsPerOp = seconds * 1e9 / static_cast<double>(batch);
+                AllocTracker::Counters after = AllocTracker::getThreadCounters();
+                result.allocsPerOp = static_cast<double>(after.count - before.count) / batch;
+                result.bytesPerOp = static_cast<double>(after.bytes - before.bytes) / batch;
+                result.opsPerSecond = seconds > 0.0 ? batch / seconds : 0.0;
+                return result;
+            }
+            // Salto directo al tamaño estimado si el lote ya es medible
+            if (seconds > minTimeSeconds / 100.0) {
+                batch = static_cast<uint64_t>(batch * (minTimeSeconds * 1.2 / seconds)) + 1;
+            } else {
+                batch *= 2;
+            }
+        }
+    }
+    
+    void printResult(const Result& r) {
+        std::printf("%-32s %-18s %12.1f ns/op %9.2f allocs/op %11.1f B/op %12.0f ops/s\n",
+                    r.name.c_str(), r.map.c_str(), r.nsPerOp, r.allocsPerOp, r.bytesPerOp, r.opsPerSecond);
+        std::fflush(stdout);
+    }
+    
+    bool writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            std::cout.clear();
+            std::cout << "Error: No se pudo escribir " << path << std::endl;
+            return false;
+        }
+        std::fprintf(file, "{\n  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(file, "    {\"name\": \"%s\", \"map\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, "
+                               "\"allocs_per_op\": %.3f, \"bytes_per_op\": %.1f, \"ops_per_second\": %.1f}%s\n",
+                         r.name.c_str(), r.map.c_str(), static_cast<unsigned long long>(r.iterations), r.nsPerOp,
+                         r.allocsPerOp, r.bytesPerOp, r.opsPerSecond, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        std::fclose(file);
+        return true;
+    }
+    
+    void printUsage() {
+        std::cout << "Uso: dofus_bench [--filter texto] [--min-time ms] [--json ruta]" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    double minTimeSeconds = 0.2;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTimeSeconds = std::max(1, std::atoi(argv[++i])) / 1000.0;
+        } else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+    
+    // Json y Pathfinding todavía escriben en cout: se silencia para no medir
+    // la consola (los resultados van por printf)
+    Log::setLevel(LogLevel::Error);
+    std::cout.setstate(std::ios_base::badbit);
+    
+    // Mapas del repositorio más mapas generados grandes y aleatorios
+    std::vector<BenchMap> maps;
+    std::error_code error;
+    std::vector<std::filesystem::path> shipped;
+    for (const auto& entry : std::filesystem::directory_iterator("data", error)) {
+        if (entry.path().extension() == ".json") shipped.push_back(entry.path());
+    }
+    std::sort(shipped.begin(), shipped.end());
+    for (const auto& path : shipped) {
+        BenchMap bench;
+        bench.name = path.stem().string();
+        bench.path = path.string();
+        if (JsonParser::loadMapFromFile(bench.path, bench.data) && prepareMap(bench)) {
+            maps.push_back(std::move(bench));
+        }
+    }
+    
+    struct Generated { const char* name; int width; int height; int blockedPercent; uint32_t seed; };
+    const Generated generated[] = {
+        {"open_256", 256, 256, 0, 1},
+        {"random_64_p30", 64, 64, 30, 7},
+        {"random_256_p20", 256, 256, 20, 11},
+        {"random_1024_p25", 1024, 1024, 25, 13},
+    };
+    for (const auto& g : generated) {
+        BenchMap bench;
+        bench.name = g.name;
+        bench.data = generateMap(g.width, g.height, g.blockedPercent, g.seed);
+        if (prepareMap(bench)) maps.push_back(std::move(bench));
+    }
+    
+    if (maps.empty()) {
+        std::cout.clear();
+        std::cout << "Error: No hay mapas (¿se ejecuta desde la raíz del proyecto?)" << std::endl;
+        return 2;
+    }
+    
+    std::filesystem::path scratch = std::filesystem::temp_directory_path(error) / "dofus_bench";
+    std::filesystem::create_directories(scratch, error);
+    
+    std::vector<Result> results;
+    auto run = [&](const std::string& name, const BenchMap& bench, const std::function<void(size_t)>& op) {
+        std::string fullName = name + "/" + bench.name;
+        if (!filter.empty() && fullName.find(filter) == std::string::npos) return;
+        results.push_back(measure(name, bench.name, minTimeSeconds, op));
+        printResult(results.back());
+    };
+    
+    for (const BenchMap& bench : maps) {
+        const Map& map = bench.map;
+        // Los mapas enormes solo para consultas locales: A* entre puntos lejanos
+        // en 1M de losetas mide el tamaño del mapa, no el algoritmo
+        int pathDistance = bench.data.width > 256 ? 64 : 0;
+        auto pathPairs = makePairs(bench, 256, pathDistance, true, 101);
+        auto losPairs = makePairs(bench, 256, 12, false, 202);
+        std::vector<sf::Vector2i> excluded;
+        for (size_t i = 0; i < 4 && i < losPairs.size(); ++i) excluded.push_back(losPairs[i].second);
+        
+        run("findPath", bench, [&](size_t i) {
+            const auto& p = pathPairs[i % pathPairs.size()];
+            s_sink = s_sink + Pathfinding::findPath(map, p.first, p.second).size();
+        });
+        run("getReachableTiles/pm3", bench, [&](size_t i) {
+            const auto& p = losPairs[i % losPairs.size()];
+            s_sink = s_sink + Pathfinding::getReachableTiles(map, p.first, Pathfinding::MAX_MOVEMENT_POINTS).size();
+        });
+        run("getReachableTiles/pm12", bench, [&](size_t i) {
+            const auto& p = losPairs[i % losPairs.size()];
+            s_sink = s_sink + Pathfinding::getReachableTiles(map, p.first, 12).size();
+        });
+        run("getReachableTiles/excluded/pm6", bench, [&](size_t i) {
+            const auto& p = losPairs[i % losPairs.size()];
+            s_sink = s_sink + Pathfinding::getReachableTiles(map, p.first, 6, excluded).size();
+        });
+        run("hasLineOfSight", bench, [&](size_t i) {
+            const auto& p = losPairs[i % losPairs.size()];
+            s_sink = s_sink + (LineOfSight::hasLineOfSight(map, p.first, p.second) ? 1 : 0);
+        });
+        run("computeCastableCells/r1-8", bench, [&](size_t i) {
+            const auto& p = losPairs[i % losPairs.size()];
+            s_sink = s_sink + LineOfSight::computeCastableCells(map, p.first, 1, 8).size();
+        });
+        
+        // Generación de turnos de las IA: sin reservas tras la primera llamada
+        TacticalMoveGen moveGen;
+        moveGen.setMap(map);
+        std::vector<TacticalState> tacticalStates = makeTacticalStates(losPairs);
+        std::vector<TacticalAction> tacticalActions;
+        run("TacticalMoveGen::generate", bench, [&](size_t i) {
+            moveGen.generate(tacticalStates[i % tacticalStates.size()], tacticalActions);
+            s_sink = s_sink + tacticalActions.size();
+        });
+        
+        // Capas de amenaza: cada op mueve una unidad (una aportación recalculada)
+        InfluenceMap influence;
+        TacticalState moving = tacticalStates.front();
+        influence.sync(moving, map);
+        run("InfluenceMap::sync/move", bench, [&](size_t i) {
+            moving.units[i % 4].position = bench.freeCells[(i * 7919) % bench.freeCells.size()];
+            influence.sync(moving, map);
+            s_sink = s_sink + influence.getDamage(0, moving.units[0].position);
+        });
+        
+        // E/S: los generados se guardan primero para tener un archivo que leer
+        std::string savePath = (scratch / (bench.name + ".json")).string();
+        JsonParser::saveMapToFile(savePath, bench.data);
+        std::string loadPath = bench.path.empty() ? savePath : bench.path;
+        run("JsonParser::loadMapFromFile", bench, [&](size_t) {
+            MapData data;
+            JsonParser::loadMapFromFile(loadPath, data);
+            s_sink = s_sink + data.blocked.size();
+        });
+        run("JsonParser::saveMapToFile", bench, [&](size_t) {
+            s_sink = s_sink + (JsonParser::saveMapToFile(savePath, bench.data) ? 1 : 0);
+        });
+    }
+    
+    if (!jsonPath.empty() && !writeJson(jsonPath, results)) {
+        return 1;
+    }
+    Log::flush();
+    return 0;
+}
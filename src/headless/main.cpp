@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "systems/Battle.h"
+#include "systems/Json.hpp"
+#include "systems/Log.h"
+#include "systems/Replay.h"
+
+// Ejecutable sin ventana (solo enlaza DofusCore):
+//   DofusHeadless replay <archivo.dlrp> [--verbose] [--repeat N]
+//   DofusHeadless simulate [--battles N] [--map ruta] [--max-turns N] [--seed S] [--ai greedy|search|mcts]
+//                          [--units N] [--verbose]
+static void printUsage() {
+    std::cout << "Uso:" << std::endl;
+    std::cout << "  DofusHeadless replay <archivo.dlrp> [--verbose] [--repeat N]" << std::endl;
+    std::cout << "  DofusHeadless simulate [--battles N] [--map ruta] [--max-turns N] [--seed S] [--ai greedy|search|mcts]" << std::endl;
+    std::cout << "                         [--units N] [--verbose]" << std::endl;
+}
+
+static int runReplay(const std::string& path, bool verbose, int repeat) {
+    ReplayPlayer player;
+    if (!player.load(path)) {
+        return 2;
+    }
+    
+    // Los sistemas de juego registran mucho; en modo rápido se silencia
+    Log::setLevel(verbose ? LogLevel::Debug : LogLevel::Off);
+    if (!verbose) {
+        std::cout.setstate(std::ios_base::badbit);
+    }
+    
+    ReplayReport report;
+    double totalSeconds = 0.0;
+    long long totalTurns = 0;
+    for (int i = 0; i < repeat; ++i) {
+        report = player.run();
+        totalSeconds += report.seconds;
+        totalTurns += report.turns;
+        if (report.mismatches > 0) break;
+    }
+    
+    Log::flush();
+    std::cout.clear();
+    std::cout << "Repetición: " << path << std::endl;
+    std::cout << "  registros=" << player.getRecords().size()
+              << " comandos=" << report.commands
+              << " ticks=" << report.ticks
+              << " turnos=" << report.turns << std::endl;
+    std::cout << "  checkpoints=" << report.checkpoints
+              << " discrepancias=" << report.mismatches;
+    if (report.mismatches > 0) {
+        std::cout << " (primera en tick " << report.firstMismatchTick << ")";
+    }
+    std::cout << std::endl;
+    std::cout << "  hash final=0x" << std::hex << report.finalHash << std::dec << std::endl;
+    if (totalSeconds > 0.0) {
+        std::cout << "  " << static_cast<long long>(totalTurns / totalSeconds) << " turnos/s ("
+                  << totalSeconds * 1000.0 << " ms)" << std::endl;
+    }
+    
+    return report.mismatches > 0 ? 1 : 0;
+}
+
+// Casilla libre más cercana (BFS) a anchor que no esté ocupada
+static sf::Vector2i findSpawnCell(const Battle& battle, sf::Vector2i anchor) {
+    const Map& map = battle.getMap();
+    auto isFree = [&](sf::Vector2i cell) {
+        if (!map.isValidPosition(cell.x, cell.y) || map.isBlocked(cell.x, cell.y)) return false;
+        for (const auto& entity : battle.getEntities()) {
+            if (entity.getPosition() == cell) return false;
+        }
+        return true;
+    };
+    
+    std::vector<sf::Vector2i> queue = {anchor};
+    std::vector<bool> visited(static_cast<size_t>(map.getWidth()) * map.getHeight(), false);
+    if (map.isValidPosition(anchor.x, anchor.y)) visited[anchor.y * map.getWidth() + anchor.x] = true;
+    static const sf::Vector2i directions[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    for (size_t head = 0; head < queue.size(); ++head) {
+        if (isFree(queue[head])) return queue[head];
+        for (sf::Vector2i direction : directions) {
+            sf::Vector2i next = queue[head] + direction;
+            if (!map.isValidPosition(next.x, next.y)) continue;
+            size_t index = static_cast<size_t>(next.y) * map.getWidth() + next.x;
+            if (visited[index]) continue;
+            visited[index] = true;
+            queue.push_back(next);
+        }
+    }
+    return anchor;
+}
+
+// Dos equipos alternados: el 0 (ScriptedPlayer) junto a (7,7) y el 1 (IA)
+// junto a (10,10). Con más de dos unidades la iniciativa sale de la semilla.
+static void addUnits(Battle& battle, int units, uint32_t seed) {
+    uint32_t random = seed;
+    for (int i = 0; i < units; ++i) {
+        bool player = i % 2 == 0;
+        sf::Vector2i cell = findSpawnCell(battle, player ? sf::Vector2i(7, 7) : sf::Vector2i(10, 10));
+        int initiative = 0;
+        if (units > 2) {
+            random = random * 1103515245u + 12345u;
+            initiative = static_cast<int>((random >> 16) % 100);
+        }
+        battle.addEntity(cell, player ? EntityType::Player : EntityType::Enemy, player ? 0 : 1, initiative);
+    }
+}
+
+static int runSimulate(int battles, const std::string& mapPath, int maxTurns, uint32_t seed, EnemyAI ai, int units, bool verbose) {
+    MapData mapData;
+    if (!JsonParser::loadMapFromFile(mapPath, mapData)) {
+        return 2;
+    }
+    
+    Log::setLevel(verbose ? LogLevel::Debug : LogLevel::Off);
+    if (!verbose) {
+        std::cout.setstate(std::ios_base::badbit);
+    }
+    
+    int playerWins = 0, enemyWins = 0, unfinished = 0;
+    long long totalTurns = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    
+    for (int i = 0; i < battles; ++i) {
+        Battle battle;
+        battle.loadMap(mapData);
+        addUnits(battle, units, seed + static_cast<uint32_t>(i));
+        if (ai == EnemyAI::Search) {
+            // Presupuesto por nodos y no por tiempo: simulaciones reproducibles
+            TacticalAI::Config config;
+            config.timeBudgetMs = 0;
+            config.nodeBudget = 20000;
+            battle.getTurnSystem().getTacticalAI().setConfig(config);
+        } else if (ai == EnemyAI::MonteCarlo) {
+            // Simulaciones y hilos fijos, por lo mismo
+            MonteCarloAI::Config config;
+            config.timeBudgetMs = 0;
+            config.rollouts = 2000;
+            config.threads = 4;
+            battle.getTurnSystem().getMonteCarloAI().setConfig(config);
+        }
+        battle.getTurnSystem().setEnemyAI(ai);
+        battle.start();
+        
+        ScriptedPlayer script(seed + static_cast<uint32_t>(i));
+        BattleCommand command = BattleCommand::endTurn();
+        while (!battle.isOver() && battle.getTurnSystem().getTurnCount() < maxTurns) {
+            if (script.nextCommand(battle, command)) {
+                battle.execute(command);
+            }
+            battle.step();
+        }
+        
+        totalTurns += battle.getTurnSystem().getTurnCount();
+        if (!battle.isOver()) {
+            unfinished++;
+        } else if (battle.getWinningTeam() == 0) {
+            playerWins++;
+        } else {
+            enemyWins++;
+        }
+    }
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    
+    Log::flush();
+    std::cout.clear();
+    std::cout << "Simulación: " << battles << " batallas en " << mapPath
+              << " (IA " << (ai == EnemyAI::Search ? "search" : ai == EnemyAI::MonteCarlo ? "mcts" : "greedy")
+              << ", " << units << " unidades)" << std::endl;
+    std::cout << "  victorias jugador=" << playerWins << " enemigo=" << enemyWins
+              << " sin terminar=" << unfinished << std::endl;
+    std::cout << "  turnos medios=" << (battles > 0 ? static_cast<double>(totalTurns) / battles : 0.0) << std::endl;
+    if (seconds > 0.0) {
+        std::cout << "  " << static_cast<long long>(battles / seconds) << " batallas/s, "
+                  << static_cast<long long>(totalTurns / seconds) << " turnos/s ("
+                  << seconds * 1000.0 << " ms)" << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 2;
+    }
+    
+    std::string mode = argv[1];
+    bool verbose = false;
+    
+    if (mode == "replay") {
+        if (argc < 3) {
+            printUsage();
+            return 2;
+        }
+        int repeat = 1;
+        for (int i = 3; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--verbose") == 0) {
+                verbose = true;
+            } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+                repeat = std::max(1, std::atoi(argv[++i]));
+            } else {
+                printUsage();
+                return 2;
+            }
+        }
+        return runReplay(argv[2], verbose, repeat);
+    }
+    
+    if (mode == "simulate") {
+        int battles = 1000;
+        int maxTurns = 200;
+        uint32_t seed = 1;
+        std::string mapPath = "data/map01.json";
+        EnemyAI ai = EnemyAI::Greedy;
+        int units = 2;
+        for (int i = 2; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--verbose") == 0) {
+                verbose = true;
+            } else if (std::strcmp(argv[i], "--battles") == 0 && i + 1 < argc) {
+                battles = std::max(1, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--max-turns") == 0 && i + 1 < argc) {
+                maxTurns = std::max(1, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (std::strcmp(argv[i], "--units") == 0 && i + 1 < argc) {
+                units = std::clamp(std::atoi(argv[++i]), 2, TacticalState::MAX_UNITS);
+            } else if (std::strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+                mapPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--ai") == 0 && i + 1 < argc) {
+                std::string name = argv[++i];
+                if (name == "greedy") {
+                    ai = EnemyAI::Greedy;
+                } else if (name == "search") {
+                    ai = EnemyAI::Search;
+                } else if (name == "mcts") {
+                    ai = EnemyAI::MonteCarlo;
+                } else {
+                    printUsage();
+                    return 2;
+                }
+            } else {
+                printUsage();
+                return 2;
+            }
+        }
+        return runSimulate(battles, mapPath, maxTurns, seed, ai, units, verbose);
+    }
+    
+    printUsage();
+    return 2;
+}
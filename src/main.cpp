@@ -1,7 +1,58 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include "app/App.h"
+#include "systems/AssetManifest.h"
+#include "systems/Assets.h"
+#include "systems/Display.h"
 
-int main() {
-    App app;
+// Genera la caché de hojas reducidas (cache/sprites) sin abrir la ventana
+static int bakeAssets(unsigned int frameHeight) {
+    AssetManifest manifest;
+    if (!manifest.loadFromFile(AssetManifest::DEFAULT_PATH)) {
+        return 1;
+    }
+    
+    int failed = 0;
+    for (const auto& texture : manifest.getTextures()) {
+        ScaledSheet sheet;
+        if (Assets::loadScaledSheet(texture.path, texture.columns, texture.rows, frameHeight, sheet)) {
+            std::cout << texture.id << ": " << sheet.image.getSize().x << "x" << sheet.image.getSize().y << std::endl;
+        } else {
+            failed++;
+        }
+    }
+    std::cout << "Caché de sprites a " << frameHeight << " px por frame en " << Assets::SCALED_CACHE_DIR << std::endl;
+    return failed == static_cast<int>(manifest.getTextures().size()) ? 1 : 0;
+}
+
+// Opciones: --vsync | --fps N | --unlimited (por defecto límite de 120 FPS)
+//           --bake-assets [alto de frame]  (genera la caché de sprites y sale)
+int main(int argc, char** argv) {
+    FrameSettings frameSettings;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bake-assets") == 0) {
+            unsigned int frameHeight = EntityView::getAtlasFrameHeight(Display::getDesktopScale());
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                frameHeight = static_cast<unsigned int>(std::atoi(argv[i + 1]));
+            }
+            return bakeAssets(frameHeight);
+        } else if (std::strcmp(argv[i], "--vsync") == 0) {
+            frameSettings.mode = FrameMode::VSync;
+        } else if (std::strcmp(argv[i], "--unlimited") == 0) {
+            frameSettings.mode = FrameMode::Unlimited;
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            int fps = std::atoi(argv[++i]);
+            if (fps > 0) {
+                frameSettings.mode = FrameMode::Limited;
+                frameSettings.fpsLimit = static_cast<unsigned int>(fps);
+            } else {
+                frameSettings.mode = FrameMode::Unlimited;
+            }
+        }
+    }
+    
+    App app(frameSettings);
     app.run();
     return 0;
 }
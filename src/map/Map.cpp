@@ -1,45 +1,11 @@
 #include "map/Map.h"
 #include <algorithm>
-#include <iostream>
+#include "systems/Log.h"
 
-Map::Map() : m_blockedTiles(MAP_SIZE, std::vector<bool>(MAP_SIZE, false)), 
-             m_hoveredTile(-1, -1) {
-    // Offset inicial; se recalcula al aplicar letterboxing para centrar
-    m_offset = sf::Vector2f(0.0f, 0.0f);
-}
-
-void Map::render(sf::RenderWindow& window) {
-    for (int y = 0; y < MAP_SIZE; ++y) {
-        for (int x = 0; x < MAP_SIZE; ++x) {
-            sf::Vector2f screenPos = Isometric::isoToScreen(sf::Vector2i(x, y), sf::Vector2f(TILE_SIZE, TILE_SIZE));
-            screenPos += m_offset;
-            
-            sf::Color tileColor = getTileColor(x, y);
-            
-            // Resaltar la loseta bajo el cursor
-            if (x == m_hoveredTile.x && y == m_hoveredTile.y) {
-                tileColor = sf::Color::Yellow;
-            }
-            
-            auto diamond = Isometric::createDiamond(sf::Vector2f(TILE_SIZE, TILE_SIZE), tileColor);
-            diamond.setPosition(screenPos);
-            window.draw(diamond);
-        }
-    }
-}
-
-void Map::handleMouseClick(sf::Vector2f mousePos, sf::Mouse::Button button) {
-    sf::Vector2i tilePos = getTileFromPosition(mousePos);
-    
-    if (isValidPosition(tilePos.x, tilePos.y)) {
-        if (button == sf::Mouse::Button::Right) {
-            toggleTile(tilePos.x, tilePos.y);
-        }
-    }
-}
-
-void Map::updateHover(sf::Vector2f mousePos) {
-    m_hoveredTile = getTileFromPosition(mousePos);
+Map::Map(int width, int height)
+    : m_width(width),
+      m_height(height),
+      m_blockedTiles(height, std::vector<bool>(width, false)) {
 }
 
 bool Map::isBlocked(int x, int y) const {
@@ -49,89 +15,85 @@ bool Map::isBlocked(int x, int y) const {
 
 void Map::setBlocked(int x, int y, bool blocked) {
     if (isValidPosition(x, y)) {
-        m_blockedTiles[y][x] = blocked;
+        writeTile(x, y, blocked);
     }
 }
 
 bool Map::isValidPosition(int x, int y) const {
-    return x >= 0 && x < MAP_SIZE && y >= 0 && y < MAP_SIZE;
-}
-
-sf::Vector2f Map::getTileCenter(int x, int y) const {
-    sf::Vector2f screenPos = Isometric::isoToScreen(sf::Vector2i(x, y), sf::Vector2f(TILE_SIZE, TILE_SIZE));
-    screenPos += m_offset;
-    screenPos.x += TILE_SIZE * 0.5f;
-    screenPos.y += TILE_SIZE * 0.5f;
-    return screenPos;
+    return x >= 0 && x < m_width && y >= 0 && y < m_height;
 }
 
-sf::Vector2f Map::getTileTopLeft(int x, int y) const {
-    sf::Vector2f screenPos = Isometric::isoToScreen(sf::Vector2i(x, y), sf::Vector2f(TILE_SIZE, TILE_SIZE));
-    screenPos += m_offset;
-    return screenPos;
-}
-
-void Map::setCenteredOffset(sf::Vector2f viewSize) {
-    // Centrar el rombo del mapa dentro de la vista virtual 1280x720
-    // El tamaño del rombo en píxeles: ancho = MAP_SIZE*TILE_SIZE, alto = MAP_SIZE*TILE_SIZE
-    const float mapW = MAP_SIZE * TILE_SIZE;
-    const float mapH = MAP_SIZE * TILE_SIZE;
-    m_offset.x = (viewSize.x - mapW) * 0.5f;
-    m_offset.y = (viewSize.y - mapH) * 0.5f;
-}
-
-sf::Vector2i Map::getTileFromPosition(sf::Vector2f position) const {
-    sf::Vector2f relativePos = position - m_offset;
-    return Isometric::screenToIso(relativePos, sf::Vector2f(TILE_SIZE, TILE_SIZE));
+void Map::toggleTile(int x, int y) {
+    if (isValidPosition(x, y)) {
+        writeTile(x, y, !m_blockedTiles[y][x]);
+    }
 }
 
-sf::Color Map::getTileColor(int x, int y) const {
-    if (isBlocked(x, y)) {
-        return sf::Color::Red;
+void Map::writeTile(int x, int y, bool blocked) {
+    if (m_blockedTiles[y][x] == blocked) return;
+    m_blockedTiles[y][x] = blocked;
+    m_changeLog.push_back({++m_revision, sf::Vector2i(x, y)});
+    if (m_changeLog.size() > CHANGE_LOG_SIZE) {
+        m_changeLogFloor = m_changeLog.front().revision;
+        m_changeLog.pop_front();
     }
-    return sf::Color::Green;
 }
 
-void Map::toggleTile(int x, int y) {
-    if (isValidPosition(x, y)) {
-        m_blockedTiles[y][x] = !m_blockedTiles[y][x];
+bool Map::getChangesSince(uint32_t revision, std::vector<sf::Vector2i>& tiles) const {
+    tiles.clear();
+    if (revision == m_revision) return true;
+    if (revision < m_changeLogFloor) return false;
+    
+    // El registro está ordenado por revisión: recorrer desde el final
+    for (auto it = m_changeLog.rbegin(); it != m_changeLog.rend() && it->revision > revision; ++it) {
+        tiles.push_back(it->tile);
     }
+    return true;
 }
 
 bool Map::loadFromArray(int width, int height, const std::vector<uint8_t>& blocked) {
     // Validar dimensiones
-    if (width != MAP_SIZE || height != MAP_SIZE) {
-        std::cout << "Error: Dimensiones del mapa no coinciden. Esperado: " << MAP_SIZE 
-                  << "x" << MAP_SIZE << ", Obtenido: " << width << "x" << height << std::endl;
+    if (width <= 0 || height <= 0 || width > MAX_DIMENSION || height > MAX_DIMENSION) {
+        LOG_ERROR(Map, "Dimensiones del mapa inválidas. Máximo: " << MAX_DIMENSION 
+            << "x" << MAX_DIMENSION << ", Obtenido: " << width << "x" << height);
         return false;
     }
     
     if (static_cast<int>(blocked.size()) != width * height) {
-        std::cout << "Error: Tamaño del array blocked incorrecto. Esperado: " << width * height 
-                  << ", Obtenido: " << blocked.size() << std::endl;
+        LOG_ERROR(Map, "Tamaño del array blocked incorrecto. Esperado: " << width * height 
+            << ", Obtenido: " << blocked.size());
         return false;
     }
     
+    // Un tamaño distinto invalida todas las losetas (las vistas se reconstruyen enteras)
+    if (width != m_width || height != m_height) {
+        m_width = width;
+        m_height = height;
+        m_blockedTiles.assign(height, std::vector<bool>(width, false));
+        m_changeLog.clear();
+        m_changeLogFloor = ++m_revision;
+    }
+    
     // Cargar datos
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
             int index = y * width + x;
-            m_blockedTiles[y][x] = (blocked[index] != 0);
+            writeTile(x, y, blocked[index] != 0);
         }
     }
     
-    std::cout << "Mapa cargado desde array: " << width << "x" << height << " con " 
-              << std::count(blocked.begin(), blocked.end(), 1) << " casillas bloqueadas" << std::endl;
+    LOG_DEBUG(Map, "Mapa cargado desde array: " << width << "x" << height << " con " 
+        << std::count(blocked.begin(), blocked.end(), 1) << " casillas bloqueadas");
     
     return true;
 }
 
 std::vector<uint8_t> Map::exportBlockedLinear() const {
     std::vector<uint8_t> result;
-    result.reserve(MAP_SIZE * MAP_SIZE);
+    result.reserve(static_cast<size_t>(m_width) * m_height);
     
-    for (int y = 0; y < MAP_SIZE; ++y) {
-        for (int x = 0; x < MAP_SIZE; ++x) {
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
             result.push_back(m_blockedTiles[y][x] ? 1 : 0);
         }
     }
@@ -1,40 +1,51 @@
 #pragma once
-#include <SFML/Graphics.hpp>
-#include <vector>
 #include <SFML/System.hpp>
-#include "map/Isometric.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
 
+// Rejilla lógica del tablero (sin dependencias gráficas). La representación
+// en pantalla vive en MapView.
 class Map {
 public:
-    static constexpr int MAP_SIZE = 15;
-    static constexpr float TILE_SIZE = 40.0f;
+    static constexpr int MAP_SIZE = 15;        // Tamaño por defecto (arena clásica)
+    static constexpr int MAX_DIMENSION = 4096; // Límite de ancho/alto al cargar
     
-    Map();
-    
-    void render(sf::RenderWindow& window);
-    void handleMouseClick(sf::Vector2f mousePos, sf::Mouse::Button button);
-    void updateHover(sf::Vector2f mousePos);
+    Map(int width = MAP_SIZE, int height = MAP_SIZE);
     
     bool isBlocked(int x, int y) const;
     void setBlocked(int x, int y, bool blocked);
+    void toggleTile(int x, int y);
     bool isValidPosition(int x, int y) const;
     
-    sf::Vector2f getTileCenter(int x, int y) const;
-    sf::Vector2f getTileTopLeft(int x, int y) const;
-    void setCenteredOffset(sf::Vector2f viewSize);
-    sf::Vector2i getTileFromPosition(sf::Vector2f position) const;
-    
-    // Métodos para carga/guardado de mapas
+    // Métodos para carga/guardado de mapas (redimensiona si el tamaño cambia)
     bool loadFromArray(int width, int height, const std::vector<uint8_t>& blocked);
     std::vector<uint8_t> exportBlockedLinear() const;
-    int getWidth() const { return MAP_SIZE; }
-    int getHeight() const { return MAP_SIZE; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    
+    // Revisiones de cambios: cada modificación real de una loseta incrementa la
+    // revisión global y se anota en un registro acotado. Las vistas guardan la
+    // revisión que ya tienen construida y piden solo las losetas cambiadas.
+    static constexpr size_t CHANGE_LOG_SIZE = 4096;
+    uint32_t getRevision() const { return m_revision; }
+    // Losetas cambiadas después de `revision`. Devuelve false si el registro ya
+    // no cubre esa revisión (cambio de tamaño o demasiados cambios): hay que
+    // reconstruir todo.
+    bool getChangesSince(uint32_t revision, std::vector<sf::Vector2i>& tiles) const;
     
 private:
+    struct TileChange {
+        uint32_t revision;
+        sf::Vector2i tile;
+    };
+    
+    int m_width;
+    int m_height;
     std::vector<std::vector<bool>> m_blockedTiles;
-    sf::Vector2i m_hoveredTile;
-    sf::Vector2f m_offset;
+    uint32_t m_revision = 1;
+    std::deque<TileChange> m_changeLog;
+    uint32_t m_changeLogFloor = 1; // Revisión más antigua recuperable desde el registro
     
-    sf::Color getTileColor(int x, int y) const;
-    void toggleTile(int x, int y);
+    void writeTile(int x, int y, bool blocked);
 };
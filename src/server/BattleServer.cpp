@@ -0,0 +1,168 @@
+#include "server/BattleServer.h"
+#include <algorithm>
+
+BattleServer::BattleServer(unsigned int workerCount) : m_pool(workerCount) {
+    m_stepMicros.resize(m_pool.getWorkerCount());
+}
+
+BattleServer::~BattleServer() {
+    m_pool.waitIdle();
+}
+
+int BattleServer::createBattle(const MapData& map, sf::Vector2i playerStart, sf::Vector2i enemyStart, int maxTurns) {
+    auto session = std::make_unique<BattleSession>();
+    session->id = static_cast<int>(m_sessions.size());
+    session->maxTurns = maxTurns;
+    session->battle.loadMap(map);
+    session->battle.addEntity(playerStart, EntityType::Player);
+    session->battle.addEntity(enemyStart, EntityType::Enemy);
+    session->battle.start();
+    m_sessions.push_back(std::move(session));
+    return m_sessions.back()->id;
+}
+
+void BattleServer::start() {
+    m_startTime = std::chrono::steady_clock::now();
+    for (auto& session : m_sessions) {
+        schedule(*session);
+    }
+}
+
+void BattleServer::submit(int battleId, const BattleCommand& command) {
+    BattleSession& session = *m_sessions[battleId];
+    {
+        std::lock_guard<std::mutex> lock(session.inboxMutex);
+        session.inbox.push_back(command);
+    }
+    
+    // Reanudar si estaba esperando; si está en ejecución, el worker verá el inbox al terminar
+    SessionState expected = SessionState::WaitingInput;
+    if (session.state.compare_exchange_strong(expected, SessionState::Queued)) {
+        schedule(session);
+    }
+}
+
+bool BattleServer::popInputRequest(int& battleId, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_requestMutex);
+    if (!m_requestAvailable.wait_for(lock, timeout, [this] { return !m_inputRequests.empty(); })) {
+        return false;
+    }
+    battleId = m_inputRequests.front();
+    m_inputRequests.pop_front();
+    return true;
+}
+
+void BattleServer::waitUntilFinished() {
+    std::unique_lock<std::mutex> lock(m_doneMutex);
+    m_done.wait(lock, [this] { return allFinished(); });
+}
+
+ServerReport BattleServer::getReport() const {
+    ServerReport report;
+    report.battles = static_cast<int>(m_sessions.size());
+    report.finished = m_finished.load();
+    report.turns = m_turns.load();
+    report.steps = m_steps.load();
+    
+    auto end = allFinished() ? m_endTime : std::chrono::steady_clock::now();
+    report.seconds = std::chrono::duration<double>(end - m_startTime).count();
+    if (report.seconds > 0.0) {
+        report.battlesPerSecond = report.finished / report.seconds;
+        report.turnsPerSecond = report.turns / report.seconds;
+    }
+    
+    std::vector<float> all;
+    for (const auto& samples : m_stepMicros) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    if (!all.empty()) {
+        auto percentile = [&all](double p) {
+            size_t index = std::min(all.size() - 1, static_cast<size_t>(p * (all.size() - 1) + 0.5));
+            std::nth_element(all.begin(), all.begin() + index, all.end());
+            return static_cast<double>(all[index]);
+        };
+        report.p50StepMicros = percentile(0.50);
+        report.p99StepMicros = percentile(0.99);
+        report.maxStepMicros = *std::max_element(all.begin(), all.end());
+    }
+    return report;
+}
+
+void BattleServer::schedule(BattleSession& session) {
+    m_pool.submit([this, &session] { runStep(session); });
+}
+
+bool BattleServer::needsInput(const Battle& battle) const {
+    const TurnSystem& turns = battle.getTurnSystem();
+    const Entity* player = turns.getPlayer();
+    return turns.isPlayerTurn() && player && !player->isMoving();
+}
+
+void BattleServer::runStep(BattleSession& session) {
+    auto stepStart = std::chrono::steady_clock::now();
+    session.state.store(SessionState::Running);
+    
+    std::vector<BattleCommand> commands;
+    {
+        std::lock_guard<std::mutex> lock(session.inboxMutex);
+        commands.swap(session.inbox);
+    }
+    
+    Battle& battle = session.battle;
+    const TurnSystem& turns = battle.getTurnSystem();
+    // Antes de los comandos: un EndTurn del driver también cuenta como turno
+    const int initialTurn = turns.getTurnCount();
+    for (const auto& command : commands) {
+        battle.execute(command);
+    }
+    
+    // Avanzar hasta el cambio de turno, el final de la batalla o la espera de input
+    const int startTurn = turns.getTurnCount();
+    for (int ticks = 0; ticks < MAX_TICKS_PER_STEP; ++ticks) {
+        if (battle.isOver() || turns.getTurnCount() != startTurn || needsInput(battle)) break;
+        battle.step();
+    }
+    
+    m_turns += turns.getTurnCount() - initialTurn;
+    m_steps++;
+    float micros = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - stepStart).count();
+    m_stepMicros[ThreadPool::currentWorkerIndex()].push_back(micros);
+    
+    if (battle.isOver() || turns.getTurnCount() >= session.maxTurns) {
+        session.state.store(SessionState::Finished);
+        if (m_finished.fetch_add(1) + 1 == static_cast<int>(m_sessions.size())) {
+            std::lock_guard<std::mutex> lock(m_doneMutex);
+            m_endTime = std::chrono::steady_clock::now();
+            m_done.notify_all();
+        }
+    } else if (needsInput(battle)) {
+        requestInput(session);
+    } else {
+        session.state.store(SessionState::Queued);
+        schedule(session);
+    }
+}
+
+void BattleServer::requestInput(BattleSession& session) {
+    session.state.store(SessionState::WaitingInput);
+    
+    // Un comando pudo llegar mientras la batalla se ejecutaba
+    bool hasPending;
+    {
+        std::lock_guard<std::mutex> lock(session.inboxMutex);
+        hasPending = !session.inbox.empty();
+    }
+    if (hasPending) {
+        SessionState expected = SessionState::WaitingInput;
+        if (session.state.compare_exchange_strong(expected, SessionState::Queued)) {
+            schedule(session);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        m_inputRequests.push_back(session.id);
+    }
+    m_requestAvailable.notify_one();
+}
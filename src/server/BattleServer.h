@@ -0,0 +1,94 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "systems/Battle.h"
+#include "systems/ThreadPool.h"
+
+// Estado de una batalla dentro del servidor
+enum class SessionState {
+    Queued,        // En la cola del pool
+    Running,       // Un worker la está avanzando
+    WaitingInput,  // Turno del jugador: espera un comando externo
+    Finished
+};
+
+struct BattleSession {
+    int id = 0;
+    int maxTurns = 0;
+    Battle battle;
+    std::atomic<SessionState> state{SessionState::Queued};
+    
+    // Comandos recibidos mientras la batalla no se ejecuta
+    std::mutex inboxMutex;
+    std::vector<BattleCommand> inbox;
+};
+
+struct ServerReport {
+    int battles = 0;
+    int finished = 0;
+    long long turns = 0;
+    long long steps = 0;
+    double seconds = 0.0;
+    double battlesPerSecond = 0.0;
+    double turnsPerSecond = 0.0;
+    double p50StepMicros = 0.0;
+    double p99StepMicros = 0.0;
+    double maxStepMicros = 0.0;
+};
+
+// Aloja muchas batallas independientes sobre un pool fijo de hilos. Cada tarea
+// avanza una batalla un paso de turno: aplica los comandos pendientes y simula
+// hasta que cambia el turno, termina la batalla o se necesita input del jugador.
+class BattleServer {
+public:
+    static constexpr int MAX_TICKS_PER_STEP = 600; // 10 s de simulación por tarea como máximo
+    
+    explicit BattleServer(unsigned int workerCount = 0);
+    ~BattleServer();
+    
+    // Crear batallas antes de start()
+    int createBattle(const MapData& map, sf::Vector2i playerStart, sf::Vector2i enemyStart, int maxTurns);
+    void start();
+    
+    // Entrada de comandos (desde cualquier hilo)
+    void submit(int battleId, const BattleCommand& command);
+    
+    // Siguiente batalla que espera un comando del jugador; false si expira el timeout
+    bool popInputRequest(int& battleId, std::chrono::milliseconds timeout);
+    
+    // Solo es seguro leer la batalla mientras está en WaitingInput o Finished
+    const Battle& getBattle(int battleId) const { return m_sessions[battleId]->battle; }
+    
+    bool allFinished() const { return m_finished.load() == static_cast<int>(m_sessions.size()); }
+    void waitUntilFinished();
+    ServerReport getReport() const;
+    
+private:
+    ThreadPool m_pool;
+    std::vector<std::unique_ptr<BattleSession>> m_sessions;
+    
+    // Peticiones de input pendientes (lo que en red sería "es tu turno")
+    std::mutex m_requestMutex;
+    std::condition_variable m_requestAvailable;
+    std::deque<int> m_inputRequests;
+    
+    // Estadísticas
+    std::atomic<int> m_finished{0};
+    std::atomic<long long> m_turns{0};
+    std::atomic<long long> m_steps{0};
+    std::vector<std::vector<float>> m_stepMicros; // Una lista por worker, sin locks
+    std::chrono::steady_clock::time_point m_startTime;
+    std::chrono::steady_clock::time_point m_endTime;
+    std::mutex m_doneMutex;
+    std::condition_variable m_done;
+    
+    void schedule(BattleSession& session);
+    void runStep(BattleSession& session);
+    void requestInput(BattleSession& session);
+    bool needsInput(const Battle& battle) const;
+};
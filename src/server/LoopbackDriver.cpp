@@ -0,0 +1,24 @@
+#include "server/LoopbackDriver.h"
+
+LoopbackDriver::LoopbackDriver(BattleServer& server, int battleCount, uint32_t seed) : m_server(server) {
+    m_scripts.reserve(battleCount);
+    for (int i = 0; i < battleCount; ++i) {
+        m_scripts.emplace_back(seed + static_cast<uint32_t>(i));
+    }
+}
+
+void LoopbackDriver::run() {
+    while (!m_server.allFinished()) {
+        int battleId;
+        if (!m_server.popInputRequest(battleId, std::chrono::milliseconds(10))) {
+            continue;
+        }
+        
+        BattleCommand command = BattleCommand::endTurn();
+        if (!m_scripts[battleId].nextCommand(m_server.getBattle(battleId), command)) {
+            command = BattleCommand::endTurn();
+        }
+        m_server.submit(battleId, command);
+        m_commandsSent++;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include "server/BattleServer.h"
+
+// Cliente local para pruebas de carga: atiende las peticiones de input del
+// servidor con un ScriptedPlayer por batalla, como haría un cliente de red.
+class LoopbackDriver {
+public:
+    LoopbackDriver(BattleServer& server, int battleCount, uint32_t seed);
+    
+    // Bucle hasta que todas las batallas terminen
+    void run();
+    
+    long long getCommandsSent() const { return m_commandsSent.load(); }
+    
+private:
+    BattleServer& m_server;
+    std::vector<ScriptedPlayer> m_scripts;
+    std::atomic<long long> m_commandsSent{0};
+};
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "server/BattleServer.h"
+#include "server/LoopbackDriver.h"
+#include "systems/Json.hpp"
+#include "systems/Log.h"
+
+// Servidor de simulación multi-batalla con driver loopback para pruebas de carga:
+//   DofusServer [--battles N] [--workers N] [--map ruta] [--max-turns N] [--seed S] [--verbose]
+static void printUsage() {
+    std::cout << "Uso: DofusServer [--battles N] [--workers N] [--map ruta] [--max-turns N] [--seed S] [--verbose]" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int battles = 5000;
+    unsigned int workers = 0;
+    int maxTurns = 200;
+    uint32_t seed = 1;
+    bool verbose = false;
+    std::string mapPath = "data/map01.json";
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (std::strcmp(argv[i], "--battles") == 0 && i + 1 < argc) {
+            battles = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--max-turns") == 0 && i + 1 < argc) {
+            maxTurns = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--map") == 0 && i + 1 < argc) {
+            mapPath = argv[++i];
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    MapData mapData;
+    if (!JsonParser::loadMapFromFile(mapPath, mapData)) {
+        return 2;
+    }
+
+    // El log de los sistemas de juego solo se ve con --verbose; lo que aún
+    // escribe directamente a std::cout se silencia durante la carga
+    Log::setLevel(verbose ? LogLevel::Debug : LogLevel::Off);
+    if (!verbose) {
+        std::cout.setstate(std::ios_base::badbit);
+    }
+
+    BattleServer server(workers);
+    for (int i = 0; i < battles; ++i) {
+        server.createBattle(mapData, sf::Vector2i(7, 7), sf::Vector2i(10, 10), maxTurns);
+    }
+
+    LoopbackDriver driver(server, battles, seed);
+    server.start();
+    driver.run();
+    server.waitUntilFinished();
+
+    ServerReport report = server.getReport();
+    Log::flush();
+    std::cout.clear();
+    std::cout << "DofusServer: " << report.battles << " batallas, " << workers << " workers (0=auto)" << std::endl;
+    std::cout << "  terminadas=" << report.finished << " turnos=" << report.turns
+              << " pasos=" << report.steps << " comandos=" << driver.getCommandsSent() << std::endl;
+    std::cout << "  " << static_cast<long long>(report.battlesPerSecond) << " batallas/s, "
+              << static_cast<long long>(report.turnsPerSecond) << " turnos/s ("
+              << report.seconds * 1000.0 << " ms)" << std::endl;
+    std::cout << "  latencia por paso de turno: p50=" << report.p50StepMicros << "us p99="
+              << report.p99StepMicros << "us max=" << report.maxStepMicros << "us" << std::endl;
+    return 0;
+}
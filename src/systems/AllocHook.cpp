@@ -0,0 +1,33 @@
+#include <cstdlib>
+#include <new>
+#include "systems/AllocTracker.h"
+
+// Sustituye el operator new global para contar reservas (AllocTracker). Se
+// compila aparte (biblioteca objeto DofusAllocHook) y solo se enlaza en los
+// ejecutables que lo piden: las variantes nothrow y de array acaban aquí; las
+// alineadas (C++17) no se cuentan.
+void* operator new(std::size_t size) {
+    AllocTracker::onAllocate(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,13 @@
+#include "systems/AllocTracker.h"
+#include <cstdlib>
+#include "systems/Log.h"
+
+thread_local AllocTracker::Counters AllocTracker::s_threadCounters;
+std::atomic<uint64_t> AllocTracker::s_processCount{0};
+
+void AllocTracker::reportViolation(const char* zone, uint64_t count, uint64_t bytes) {
+    LOG_ERROR(Core, "Reserva de memoria en zona sin reservas '" << zone << "': "
+              << count << " reservas, " << bytes << " bytes");
+    Log::flush();
+    std::abort();
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Contadores de reservas de memoria. Los alimenta el operator new de
+// AllocHook.cpp, que solo se enlaza con la opción de CMake
+// DOFUS_TRACK_ALLOCATIONS (y siempre en dofus_bench); sin él los contadores
+// se quedan a cero. Cada hilo lleva sus propios contadores (sin atómicos) y
+// el total del proceso es un atómico relajado.
+//
+// El Profiler toma una foto de los contadores del hilo al abrir y cerrar cada
+// zona, así que las reservas quedan atribuidas a las zonas (incluidas las de
+// sus hijas). Con DOFUS_ALLOC_ASSERT (por defecto: seguimiento activo y build
+// de depuración) una zona PROFILE_ZONE_NOALLOC que reserva memoria aborta.
+#ifndef DOFUS_TRACK_ALLOCATIONS
+#define DOFUS_TRACK_ALLOCATIONS 0
+#endif
+
+#ifndef DOFUS_ALLOC_ASSERT
+#if DOFUS_TRACK_ALLOCATIONS && !defined(NDEBUG)
+#define DOFUS_ALLOC_ASSERT 1
+#else
+#define DOFUS_ALLOC_ASSERT 0
+#endif
+#endif
+
+class AllocTracker {
+public:
+    static constexpr bool ENABLED = DOFUS_TRACK_ALLOCATIONS != 0;
+    
+    struct Counters {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+    
+    // Desde operator new: no puede reservar memoria
+    static void onAllocate(size_t size) {
+        s_threadCounters.count++;
+        s_threadCounters.bytes += size;
+        s_processCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    static Counters getThreadCounters() { return s_threadCounters; }
+    static uint64_t getProcessCount() { return s_processCount.load(std::memory_order_relaxed); }
+    
+    // Una zona sin reservas reservó memoria: registra el error y aborta
+    [[noreturn]] static void reportViolation(const char* zone, uint64_t count, uint64_t bytes);
+
+private:
+    static thread_local Counters s_threadCounters;
+    static std::atomic<uint64_t> s_processCount;
+};
+
+// Comprueba que su bloque no reserve memoria en el hilo actual. Vacío si
+// DOFUS_ALLOC_ASSERT está desactivado.
+class AllocFreeScope {
+public:
+#if DOFUS_ALLOC_ASSERT
+    explicit AllocFreeScope(const char* name) : m_name(name), m_start(AllocTracker::getThreadCounters()) {}
+    ~AllocFreeScope() {
+        AllocTracker::Counters now = AllocTracker::getThreadCounters();
+        if (now.count != m_start.count) {
+            AllocTracker::reportViolation(m_name, now.count - m_start.count, now.bytes - m_start.bytes);
+        }
+    }
+#else
+    explicit AllocFreeScope(const char*) {}
+#endif
+
+    AllocFreeScope(const AllocFreeScope&) = delete;
+    AllocFreeScope& operator=(const AllocFreeScope&) = delete;
+
+#if DOFUS_ALLOC_ASSERT
+private:
+    const char* m_name;
+    AllocTracker::Counters m_start;
+#endif
+};
@@ -0,0 +1,208 @@
+#include "systems/AssetManifest.h"
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include "systems/Log.h"
+
+namespace {
+    // Lector JSON mínimo: objetos, arrays, cadenas y enteros (lo que usa el manifiesto)
+    struct JsonValue {
+        enum class Type { Null, Number, String, Array, Object } type = Type::Null;
+        long number = 0;
+        std::string text;
+        std::vector<JsonValue> items;
+        std::vector<std::pair<std::string, JsonValue>> members;
+        
+        const JsonValue* get(const std::string& key) const {
+            for (const auto& member : members) {
+                if (member.first == key) return &member.second;
+            }
+            return nullptr;
+        }
+    };
+    
+    class JsonReader {
+    public:
+        explicit JsonReader(const std::string& text) : m_text(text) {}
+        
+        bool parse(JsonValue& out) {
+            if (!parseValue(out)) return false;
+            skipSpace();
+            return m_pos == m_text.size();
+        }
+        
+        size_t getPosition() const { return m_pos; }
+        
+    private:
+        const std::string& m_text;
+        size_t m_pos = 0;
+        
+        void skipSpace() {
+            while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) m_pos++;
+        }
+        
+        bool consume(char c) {
+            skipSpace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c) {
+                m_pos++;
+                return true;
+            }
+            return false;
+        }
+        
+        bool parseString(std::string& out) {
+            if (!consume('"')) return false;
+            out.clear();
+            while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+                if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size()) m_pos++;
+                out += m_text[m_pos++];
+            }
+            return consume('"');
+        }
+        
+        bool parseValue(JsonValue& out) {
+            skipSpace();
+            if (m_pos >= m_text.size()) return false;
+            const char c = m_text[m_pos];
+            
+            if (c == '"') {
+                out.type = JsonValue::Type::String;
+                return parseString(out.text);
+            }
+            if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+                size_t end = m_pos + 1;
+                while (end < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[end]))) end++;
+                out.type = JsonValue::Type::Number;
+                out.number = std::stol(m_text.substr(m_pos, end - m_pos));
+                m_pos = end;
+                return true;
+            }
+            if (c == '[') {
+                m_pos++;
+                out.type = JsonValue::Type::Array;
+                if (consume(']')) return true;
+                do {
+                    out.items.emplace_back();
+                    if (!parseValue(out.items.back())) return false;
+                } while (consume(','));
+                return consume(']');
+            }
+            if (c == '{') {
+                m_pos++;
+                out.type = JsonValue::Type::Object;
+                if (consume('}')) return true;
+                do {
+                    std::string key;
+                    if (!parseString(key) || !consume(':')) return false;
+                    out.members.emplace_back(key, JsonValue());
+                    if (!parseValue(out.members.back().second)) return false;
+                } while (consume(','));
+                return consume('}');
+            }
+            return false;
+        }
+    };
+    
+    std::string getString(const JsonValue& object, const std::string& key) {
+        const JsonValue* value = object.get(key);
+        return value && value->type == JsonValue::Type::String ? value->text : std::string();
+    }
+    
+    unsigned int getCount(const JsonValue& object, const std::string& key) {
+        const JsonValue* value = object.get(key);
+        return value && value->type == JsonValue::Type::Number && value->number > 0 ? static_cast<unsigned int>(value->number) : 1u;
+    }
+}
+
+bool AssetManifest::loadFromFile(const std::string& path) {
+    m_textures.clear();
+    m_groups.clear();
+    m_textureIndex.clear();
+    
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        LOG_ERROR(Assets, "No se pudo abrir el manifiesto de assets: " << path);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+    
+    JsonValue root;
+    JsonReader reader(text);
+    if (!reader.parse(root) || root.type != JsonValue::Type::Object) {
+        LOG_ERROR(Assets, "Manifiesto de assets inválido cerca del carácter " << reader.getPosition() << ": " << path);
+        return false;
+    }
+    
+    if (const JsonValue* textures = root.get("textures")) {
+        for (const auto& item : textures->items) {
+            Texture texture;
+            texture.id = getString(item, "id");
+            texture.path = getString(item, "path");
+            texture.columns = getCount(item, "columns");
+            texture.rows = getCount(item, "rows");
+            if (texture.id.empty() || texture.path.empty()) {
+                LOG_WARN(Assets, "Textura sin id o ruta en " << path);
+                continue;
+            }
+            if (m_textureIndex.count(texture.id)) {
+                LOG_WARN(Assets, "Textura duplicada '" << texture.id << "' en " << path);
+                continue;
+            }
+            m_textureIndex[texture.id] = m_textures.size();
+            m_textures.push_back(texture);
+        }
+    }
+    
+    if (const JsonValue* groups = root.get("groups")) {
+        for (const auto& item : groups->items) {
+            Group group;
+            group.name = getString(item, "name");
+            if (const JsonValue* ids = item.get("textures")) {
+                for (const auto& id : ids->items) {
+                    if (!findTexture(id.text)) {
+                        LOG_WARN(Assets, "El grupo '" << group.name << "' usa la textura desconocida '" << id.text << "'");
+                        continue;
+                    }
+                    group.textures.push_back(id.text);
+                }
+            }
+            m_groups.push_back(group);
+        }
+    }
+    
+    LOG_INFO(Assets, "Manifiesto de assets: " << m_textures.size() << " texturas, " << m_groups.size() << " grupos (" << path << ")");
+    return true;
+}
+
+const AssetManifest::Texture* AssetManifest::findTexture(const std::string& id) const {
+    auto it = m_textureIndex.find(id);
+    return it != m_textureIndex.end() ? &m_textures[it->second] : nullptr;
+}
+
+const AssetManifest::Group* AssetManifest::findGroup(const std::string& name) const {
+    for (const auto& group : m_groups) {
+        if (group.name == name) return &group;
+    }
+    return nullptr;
+}
+
+std::vector<AssetManifest::Texture> AssetManifest::collectGroups(const std::vector<std::string>& groupNames) const {
+    std::vector<Texture> result;
+    std::vector<bool> added(m_textures.size(), false);
+    for (const auto& name : groupNames) {
+        const Group* group = findGroup(name);
+        if (!group) {
+            LOG_WARN(Assets, "Grupo de assets desconocido '" << name << "'");
+            continue;
+        }
+        for (const auto& id : group->textures) {
+            const size_t index = m_textureIndex.at(id);
+            if (added[index]) continue;
+            added[index] = true;
+            result.push_back(m_textures[index]);
+        }
+    }
+    return result;
+}
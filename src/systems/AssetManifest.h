@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Manifiesto de assets (assets/manifest.json): declara cada textura con su id,
+// ruta y rejilla de frames, y los grupos que se precargan juntos. Formato:
+//   { "textures": [ { "id": "heal", "path": "assets/sprites/heal.png", "columns": 3, "rows": 3 }, ... ],
+//     "groups":   [ { "name": "combat", "textures": ["heal", ...] }, ... ] }
+class AssetManifest {
+public:
+    static constexpr const char* DEFAULT_PATH = "assets/manifest.json";
+    
+    struct Texture {
+        std::string id;
+        std::string path;
+        unsigned int columns = 1;
+        unsigned int rows = 1;
+    };
+    
+    struct Group {
+        std::string name;
+        std::vector<std::string> textures;  // ids
+    };
+    
+    bool loadFromFile(const std::string& path);
+    
+    const Texture* findTexture(const std::string& id) const;
+    const Group* findGroup(const std::string& name) const;
+    // Texturas de varios grupos, sin repetir y en orden de declaración
+    std::vector<Texture> collectGroups(const std::vector<std::string>& groupNames) const;
+    
+    const std::vector<Texture>& getTextures() const { return m_textures; }
+    const std::vector<Group>& getGroups() const { return m_groups; }
+    
+private:
+    std::vector<Texture> m_textures;
+    std::vector<Group> m_groups;
+    std::unordered_map<std::string, size_t> m_textureIndex;
+};
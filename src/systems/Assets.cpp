@@ -1,37 +1,172 @@
 #include "systems/Assets.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <filesystem>
+#include "systems/ThreadPool.h"
+#include "systems/Log.h"
 
-std::unordered_map<std::string, std::unique_ptr<sf::Texture>> Assets::s_textureCache;
+// Textura única por contenido. Solo el hilo principal la crea, la modifica o
+// la destruye; los hilos de decodificación nunca la tocan.
+struct TextureResource {
+    sf::Texture texture;
+    TextureOptions options;
+    std::string label;          // Primera ruta que la pidió
+    size_t residentBytes = 0;
+    uint64_t lastUse = 0;
+    bool ready = false;
+    bool failed = false;
+};
+
+// Petición de un handle: se resuelve a un recurso (posiblemente compartido
+// con otras rutas) cuando termina la decodificación
+struct TextureHandle::Request {
+    std::shared_ptr<TextureResource> resource;
+    bool failed = false;
+};
+
+ThreadPool* Assets::s_workerPool = nullptr;
+std::unordered_map<uint64_t, std::shared_ptr<TextureResource>> Assets::s_resources;
+std::unordered_map<std::string, std::shared_ptr<TextureResource>> Assets::s_textureCache;
+std::unordered_map<std::string, std::weak_ptr<TextureHandle::Request>> Assets::s_pathRequests;
+std::unordered_map<std::string, uint64_t> Assets::s_pathKeys;
+std::deque<Assets::PendingUpload> Assets::s_uploads;
+int Assets::s_pendingDecodes = 0;
+size_t Assets::s_memoryBudget = 256u * 1024u * 1024u;
+uint64_t Assets::s_detachedKeys = 0;
+uint64_t Assets::s_useCounter = 0;
+std::mutex Assets::s_decodedMutex;
+std::vector<Assets::DecodedImage> Assets::s_decoded;
+std::mutex Assets::s_timingMutex;
+std::vector<LoadTiming> Assets::s_loadTimings;
 std::unique_ptr<sf::Texture> Assets::s_emptyTexture;
 static bool s_firstLoad = true;
 
+namespace {
+    uint64_t hashImage(const sf::Image& image) {
+        const sf::Vector2u size = image.getSize();
+        uint64_t hash = Assets::hashBytes(reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+        return Assets::hashBytes(image.getPixelsPtr(), static_cast<size_t>(size.x) * size.y * 4, hash);
+    }
+    
+    size_t estimateResidentBytes(sf::Vector2u size, const TextureOptions& options) {
+        size_t bytes = static_cast<size_t>(size.x) * size.y * 4;
+        // La cadena de mipmaps añade un tercio
+        return options.mipmaps ? bytes + bytes / 3 : bytes;
+    }
+}
+
+const sf::Texture& TextureHandle::get() const {
+    if (!isReady()) return *Assets::getEmptyTexture();
+    Assets::touch(*m_request->resource);
+    return m_request->resource->texture;
+}
+
+bool TextureHandle::isReady() const {
+    return m_request && m_request->resource && m_request->resource->ready;
+}
+
+bool TextureHandle::isFailed() const {
+    return m_request && (m_request->failed || (m_request->resource && m_request->resource->failed));
+}
+
+uint64_t Assets::hashBytes(const uint8_t* data, size_t size, uint64_t hash) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t Assets::resourceKey(uint64_t contentHash, TextureOptions options) {
+    // El mismo contenido con otro filtrado es otra textura
+    const uint8_t flags = static_cast<uint8_t>((options.smooth ? 1 : 0) | (options.mipmaps ? 2 : 0));
+    return hashBytes(&flags, 1, contentHash);
+}
+
+std::shared_ptr<TextureResource> Assets::findResource(uint64_t key) {
+    auto it = s_resources.find(key);
+    return it != s_resources.end() ? it->second : nullptr;
+}
+
+void Assets::rekeyResource(const std::shared_ptr<TextureResource>& resource, uint64_t key) {
+    for (auto it = s_resources.begin(); it != s_resources.end(); ++it) {
+        if (it->second == resource) {
+            s_resources.erase(it);
+            break;
+        }
+    }
+    auto taken = s_resources.find(key);
+    if (key == 0 || (taken != s_resources.end() && taken->second != resource)) {
+        const uint64_t serial = ++s_detachedKeys;
+        key = hashBytes(reinterpret_cast<const uint8_t*>(&serial), sizeof(serial), 0x9e3779b97f4a7c15ull);
+    }
+    s_resources[key] = resource;
+}
+
+bool Assets::isShared(const std::shared_ptr<TextureResource>& resource, const std::string& path) {
+    for (const auto& entry : s_pathKeys) {
+        if (entry.first != path && findResource(entry.second) == resource) return true;
+    }
+    for (const auto& entry : s_textureCache) {
+        if (entry.first != path && entry.second == resource) return true;
+    }
+    return false;
+}
+
+void Assets::touch(TextureResource& resource) {
+    resource.lastUse = ++s_useCounter;
+}
+
 sf::Texture* Assets::getTexture(const std::string& path) {
     // Imprimir current_path una sola vez
     if (s_firstLoad) {
-        std::cout << "current_path=" << std::filesystem::current_path() << std::endl;
+        LOG_INFO(Assets, "current_path=" << std::filesystem::current_path());
         s_firstLoad = false;
     }
     
     // Buscar en cache
     auto it = s_textureCache.find(path);
     if (it != s_textureCache.end()) {
-        return it->second.get();
+        return &it->second->texture;
     }
     
     // Cargar nueva textura
-    std::cout << "Loading texture: " << path << " ... ";
-    auto texture = std::make_unique<sf::Texture>();
-    if (texture->loadFromFile(path)) {
-        sf::Vector2u size = texture->getSize();
-        std::cout << "OK size=" << size.x << "x" << size.y << std::endl;
-        sf::Texture* ptr = texture.get();
-        s_textureCache[path] = std::move(texture);
-        return ptr;
-    } else {
-        std::cout << "FAIL" << std::endl;
+    sf::Image image;
+    if (!image.loadFromFile(path)) {
+        LOG_ERROR(Assets, "No se pudo cargar " << path);
         return nullptr;
     }
+    
+    // Mismo contenido que otra ruta: compartir la textura
+    const uint64_t key = resourceKey(hashImage(image), TextureOptions());
+    std::shared_ptr<TextureResource> resource = findResource(key);
+    if (resource && resource->ready) {
+        LOG_INFO(Assets, path << ": mismo contenido que " << resource->label);
+    } else {
+        resource = std::make_shared<TextureResource>();
+        resource->label = path;
+        if (!resource->texture.loadFromImage(image)) {
+            LOG_ERROR(Assets, "No se pudo crear la textura de " << path);
+            return nullptr;
+        }
+        resource->residentBytes = estimateResidentBytes(image.getSize(), resource->options);
+        resource->ready = true;
+        // Si la misma clave se está subiendo en segundo plano, esta va con una
+        // clave propia para que ninguna de las dos salga de s_resources
+        rekeyResource(resource, key);
+        LOG_INFO(Assets, "Textura " << path << " " << image.getSize().x << "x" << image.getSize().y);
+    }
+    
+    touch(*resource);
+    s_pathKeys[path] = key;
+    s_textureCache[path] = resource;
+    return &resource->texture;
 }
 
 sf::Texture* Assets::getEmptyTexture() {
@@ -45,4 +180,472 @@ sf::Texture* Assets::getEmptyTexture() {
 
 void Assets::clearCache() {
     s_textureCache.clear();
+    evictUnused(0);
+}
+
+void Assets::setMemoryBudget(size_t bytes) {
+    s_memoryBudget = bytes;
+    evictUnused(s_memoryBudget);
+}
+
+size_t Assets::getResidentBytes() {
+    size_t total = 0;
+    for (const auto& entry : s_resources) {
+        total += entry.second->residentBytes;
+    }
+    return total;
+}
+
+void Assets::evictUnused(size_t budget) {
+    size_t resident = getResidentBytes();
+    while (resident > budget) {
+        // Candidata: lista, sin handles ni subidas pendientes (solo la caché la
+        // referencia) y la menos usada recientemente
+        auto victim = s_resources.end();
+        for (auto it = s_resources.begin(); it != s_resources.end(); ++it) {
+            if (!it->second->ready || it->second.use_count() > 1) continue;
+            if (victim == s_resources.end() || it->second->lastUse < victim->second->lastUse) {
+                victim = it;
+            }
+        }
+        if (victim == s_resources.end()) break;
+        
+        LOG_INFO(Assets, "Expulsada " << victim->second->label << " ("
+            << victim->second->residentBytes / 1024 << " KB)");
+        resident -= victim->second->residentBytes;
+        s_resources.erase(victim);
+    }
+}
+
+void Assets::printResidencyReport() {
+    std::cout << "=== TEXTURAS RESIDENTES ===" << std::endl;
+    for (const auto& entry : s_resources) {
+        const TextureResource& resource = *entry.second;
+        const sf::Vector2u size = resource.texture.getSize();
+        std::cout << "  " << std::setw(10) << resource.residentBytes / 1024 << " KB  "
+                  << size.x << "x" << size.y << "  refs=" << entry.second.use_count() - 1
+                  << "  uso=" << resource.lastUse << (resource.ready ? "" : "  (subiendo)")
+                  << "  " << resource.label << std::endl;
+    }
+    std::cout << "  total=" << getResidentBytes() / 1024 << " KB  presupuesto="
+              << s_memoryBudget / 1024 << " KB  rutas=" << s_pathKeys.size() << std::endl;
+}
+
+namespace {
+    // Cabecera del archivo de caché (orden de bytes del host: la caché es local)
+    struct ScaledCacheHeader {
+        char magic[4] = {'D', 'L', 'S', 'C'};
+        uint32_t version = 2;
+        uint32_t columns = 0, rows = 0;
+        uint32_t sourceFrameW = 0, sourceFrameH = 0;
+        uint32_t frameW = 0, frameH = 0;
+        uint64_t sourceBytes = 0;
+        int64_t sourceTime = 0;
+    };
+    
+    // El hash de la ruta separa hojas con el mismo nombre en carpetas distintas
+    // (player/idle.png y enemy/idle.png); el nombre solo ayuda a reconocerla
+    std::filesystem::path scaledCachePath(const std::string& path, unsigned int maxFrameHeight) {
+        const std::filesystem::path source(path);
+        const std::string normalized = source.lexically_normal().generic_string();
+        const uint64_t pathHash = Assets::hashBytes(reinterpret_cast<const uint8_t*>(normalized.data()), normalized.size());
+        char hex[17];
+        std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(pathHash));
+        return std::filesystem::path(Assets::SCALED_CACHE_DIR) /
+               (source.stem().string() + "_" + hex + "_" + std::to_string(maxFrameHeight) + ".rgba");
+    }
+    
+    // Reduce cada frame de la rejilla por separado (promedio de área con alfa
+    // premultiplicado) para que los frames reducidos sigan alineados
+    sf::Image downscaleFrames(const sf::Image& source, const ScaledSheet& sheet) {
+        sf::Image result({sheet.columns * sheet.frameSize.x, sheet.rows * sheet.frameSize.y}, sf::Color::Transparent);
+        const sf::Vector2u src = sheet.sourceFrameSize;
+        const sf::Vector2u dst = sheet.frameSize;
+        
+        for (unsigned int frame = 0; frame < sheet.columns * sheet.rows; ++frame) {
+            const unsigned int sx0 = (frame % sheet.columns) * src.x;
+            const unsigned int sy0 = (frame / sheet.columns) * src.y;
+            const unsigned int dx0 = (frame % sheet.columns) * dst.x;
+            const unsigned int dy0 = (frame / sheet.columns) * dst.y;
+            
+            for (unsigned int y = 0; y < dst.y; ++y) {
+                const unsigned int ya = y * src.y / dst.y;
+                const unsigned int yb = std::max(ya + 1, (y + 1) * src.y / dst.y);
+                for (unsigned int x = 0; x < dst.x; ++x) {
+                    const unsigned int xa = x * src.x / dst.x;
+                    const unsigned int xb = std::max(xa + 1, (x + 1) * src.x / dst.x);
+                    
+                    uint64_t r = 0, g = 0, b = 0, a = 0, count = 0;
+                    for (unsigned int py = ya; py < yb; ++py) {
+                        for (unsigned int px = xa; px < xb; ++px) {
+                            const sf::Color c = source.getPixel({sx0 + px, sy0 + py});
+                            r += c.r * c.a;
+                            g += c.g * c.a;
+                            b += c.b * c.a;
+                            a += c.a;
+                            count++;
+                        }
+                    }
+                    sf::Color out = sf::Color::Transparent;
+                    if (a > 0) {
+                        out = sf::Color(static_cast<uint8_t>(r / a), static_cast<uint8_t>(g / a),
+                                        static_cast<uint8_t>(b / a), static_cast<uint8_t>(a / count));
+                    }
+                    result.setPixel({dx0 + x, dy0 + y}, out);
+                }
+            }
+        }
+        return result;
+    }
+}
+
+bool Assets::loadScaledSheet(const std::string& path, unsigned int columns, unsigned int rows,
+                             unsigned int maxFrameHeight, ScaledSheet& sheet) {
+    std::error_code error;
+    const uint64_t sourceBytes = std::filesystem::file_size(path, error);
+    if (error) {
+        LOG_ERROR(Assets, "No existe " << path);
+        return false;
+    }
+    const int64_t sourceTime = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+    const std::filesystem::path cachePath = scaledCachePath(path, maxFrameHeight);
+    
+    // 1) Caché en disco: lectura directa sin decodificar PNG
+    if (maxFrameHeight > 0) {
+        std::ifstream in(cachePath, std::ios::binary);
+        ScaledCacheHeader header;
+        const ScaledCacheHeader expected;
+        if (in.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+            std::equal(header.magic, header.magic + 4, expected.magic) && header.version == expected.version &&
+            header.columns == columns && header.rows == rows &&
+            header.sourceBytes == sourceBytes && header.sourceTime == sourceTime) {
+            const sf::Vector2u size(header.columns * header.frameW, header.rows * header.frameH);
+            std::vector<uint8_t> pixels(static_cast<size_t>(size.x) * size.y * 4);
+            if (in.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()))) {
+                sheet.image = sf::Image(size, pixels.data());
+                sheet.columns = header.columns;
+                sheet.rows = header.rows;
+                sheet.sourceFrameSize = {header.sourceFrameW, header.sourceFrameH};
+                sheet.frameSize = {header.frameW, header.frameH};
+                sheet.fromCache = true;
+                return true;
+            }
+        }
+    }
+    
+    // 2) PNG original
+    sf::Image source;
+    if (!source.loadFromFile(path)) {
+        LOG_ERROR(Assets, "No se pudo cargar " << path);
+        return false;
+    }
+    sheet.columns = std::max(1u, columns);
+    sheet.rows = std::max(1u, rows);
+    sheet.fromCache = false;
+    if (source.getSize().x % sheet.columns != 0 || source.getSize().y % sheet.rows != 0) {
+        LOG_WARN(Assets, path << " (" << source.getSize().x << "x" << source.getSize().y
+                 << ") no se divide en " << sheet.columns << "x" << sheet.rows << " frames");
+    }
+    sheet.sourceFrameSize = {source.getSize().x / sheet.columns, source.getSize().y / sheet.rows};
+    
+    if (maxFrameHeight == 0 || sheet.sourceFrameSize.y <= maxFrameHeight) {
+        sheet.frameSize = sheet.sourceFrameSize;
+        sheet.image = std::move(source);
+        return true;
+    }
+    
+    const float ratio = static_cast<float>(maxFrameHeight) / static_cast<float>(sheet.sourceFrameSize.y);
+    sheet.frameSize = {std::max(1u, static_cast<unsigned int>(std::lround(sheet.sourceFrameSize.x * ratio))), maxFrameHeight};
+    sheet.image = downscaleFrames(source, sheet);
+    
+    // 3) Guardar en caché para el próximo arranque
+    std::filesystem::create_directories(cachePath.parent_path(), error);
+    std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+    if (out.is_open()) {
+        ScaledCacheHeader header;
+        header.columns = sheet.columns;
+        header.rows = sheet.rows;
+        header.sourceFrameW = sheet.sourceFrameSize.x;
+        header.sourceFrameH = sheet.sourceFrameSize.y;
+        header.frameW = sheet.frameSize.x;
+        header.frameH = sheet.frameSize.y;
+        header.sourceBytes = sourceBytes;
+        header.sourceTime = sourceTime;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(sheet.image.getPixelsPtr()),
+                  static_cast<std::streamsize>(static_cast<size_t>(sheet.image.getSize().x) * sheet.image.getSize().y * 4));
+    }
+    LOG_INFO(Assets, path << ": frames " << sheet.sourceFrameSize.x << "x" << sheet.sourceFrameSize.y
+             << " -> " << sheet.frameSize.x << "x" << sheet.frameSize.y << " (" << cachePath.string() << ")");
+    return true;
+}
+
+void Assets::setWorkerPool(ThreadPool* pool) {
+    s_workerPool = pool;
+}
+
+TextureHandle Assets::getTextureAsync(const std::string& path, TextureOptions options) {
+    // Petición viva para la misma ruta: compartirla
+    auto it = s_pathRequests.find(path);
+    if (it != s_pathRequests.end()) {
+        if (auto request = it->second.lock()) {
+            TextureHandle handle;
+            handle.m_request = request;
+            return handle;
+        }
+    }
+    
+    // Ruta ya decodificada cuyo contenido sigue residente: sin volver a leerla
+    TextureHandle handle;
+    auto key = s_pathKeys.find(path);
+    std::shared_ptr<TextureResource> resource = key != s_pathKeys.end() ? findResource(key->second) : nullptr;
+    if (resource && resource->options.smooth == options.smooth && resource->options.mipmaps == options.mipmaps) {
+        handle.m_request = std::make_shared<TextureHandle::Request>();
+        handle.m_request->resource = resource;
+    } else {
+        handle = startLoad(path, path, [path](sf::Image& image) { return image.loadFromFile(path); }, options);
+    }
+    s_pathRequests[path] = handle.m_request;
+    return handle;
+}
+
+TextureHandle Assets::createTextureAsync(sf::Image image, TextureOptions options, const std::string& label) {
+    // La imagen se mueve a la tarea: el hash del contenido también se calcula fuera
+    auto shared = std::make_shared<sf::Image>(std::move(image));
+    return startLoad(std::string(), label, [shared](sf::Image& out) {
+        out = std::move(*shared);
+        return true;
+    }, options);
+}
+
+TextureHandle Assets::startLoad(const std::string& path, const std::string& label, std::function<bool(sf::Image&)> decode,
+                               TextureOptions options, std::shared_ptr<TextureResource> replaces) {
+    TextureHandle handle;
+    handle.m_request = std::make_shared<TextureHandle::Request>();
+    
+    auto task = [request = handle.m_request, path, label, options, decode = std::move(decode), replaces]() {
+        DecodedImage result{request, path, label, sf::Image(), options, 0, 0.0, false, replaces};
+        const auto start = std::chrono::steady_clock::now();
+        result.ok = decode(result.image);
+        result.decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (result.ok) {
+            result.contentHash = resourceKey(hashImage(result.image), options);
+        }
+        std::lock_guard<std::mutex> lock(s_decodedMutex);
+        s_decoded.push_back(std::move(result));
+    };
+    
+    s_pendingDecodes++;
+    if (s_workerPool) {
+        s_workerPool->submit(std::move(task));
+    } else {
+        task();
+    }
+    return handle;
+}
+
+bool Assets::processUploads(sf::Time budget) {
+    bool resolved = false;
+    
+    // Recoger lo que terminaron de decodificar los hilos
+    if (s_pendingDecodes > 0) {
+        std::vector<DecodedImage> decoded;
+        {
+            std::lock_guard<std::mutex> lock(s_decodedMutex);
+            decoded.swap(s_decoded);
+        }
+        for (auto& result : decoded) {
+            s_pendingDecodes--;
+            if (!result.ok) {
+                LOG_ERROR(Assets, "No se pudo cargar " << result.path);
+                result.request->failed = true;
+                resolved = true;
+                continue;
+            }
+            if (!result.path.empty()) {
+                s_pathKeys[result.path] = result.contentHash;
+            }
+            
+            // Recarga: subir a una copia de trabajo; la antigua se sigue viendo
+            if (result.replaces) {
+                auto staging = std::make_shared<TextureResource>();
+                staging->options = result.options;
+                staging->label = result.path;
+                staging->residentBytes = estimateResidentBytes(result.image.getSize(), result.options);
+                
+                LoadTiming timing;
+                timing.label = staging->label + " (recarga)";
+                timing.decodeMs = result.decodeMs;
+                timing.bytes = staging->residentBytes;
+                s_uploads.push_back({staging, std::move(result.image), 0, timing, result.replaces, result.contentHash,
+                                     result.path});
+                continue;
+            }
+            
+            // Mismo contenido ya residente o subiéndose: compartir el recurso
+            if (auto existing = findResource(result.contentHash)) {
+                LOG_INFO(Assets, (result.path.empty() ? "imagen" : result.path)
+                    << " comparte textura con " << existing->label);
+                result.request->resource = existing;
+                resolved = resolved || existing->ready;
+                continue;
+            }
+            
+            auto resource = std::make_shared<TextureResource>();
+            resource->options = result.options;
+            resource->label = !result.label.empty() ? result.label :
+                "imagen " + std::to_string(result.image.getSize().x) + "x" + std::to_string(result.image.getSize().y);
+            resource->residentBytes = estimateResidentBytes(result.image.getSize(), result.options);
+            s_resources[result.contentHash] = resource;
+            result.request->resource = resource;
+            
+            LoadTiming timing;
+            timing.label = resource->label;
+            timing.decodeMs = result.decodeMs;
+            timing.bytes = resource->residentBytes;
+            s_uploads.push_back({resource, std::move(result.image), 0, timing, nullptr, result.contentHash,
+                                 std::string()});
+        }
+    }
+    
+    // Subir por franjas hasta agotar el presupuesto (al menos una por frame)
+    sf::Clock clock;
+    sf::Time elapsed;
+    while (!s_uploads.empty()) {
+        PendingUpload& upload = s_uploads.front();
+        TextureResource& resource = *upload.resource;
+        const sf::Vector2u size = upload.image.getSize();
+        
+        if (upload.nextRow == 0 && !resource.texture.resize(size)) {
+            LOG_ERROR(Assets, "No se pudo crear una textura de " << size.x << "x" << size.y);
+            resource.failed = true;
+            resolved = true;
+            for (auto it = s_resources.begin(); it != s_resources.end(); ++it) {
+                if (it->second == upload.resource) {
+                    s_resources.erase(it);
+                    break;
+                }
+            }
+            s_uploads.pop_front();
+            continue;
+        }
+        
+        const unsigned int rows = std::min(UPLOAD_ROWS, size.y - upload.nextRow);
+        resource.texture.update(upload.image.getPixelsPtr() + static_cast<size_t>(upload.nextRow) * size.x * 4,
+                                {size.x, rows}, {0u, upload.nextRow});
+        upload.nextRow += rows;
+        
+        if (upload.nextRow >= size.y) {
+            resource.texture.setSmooth(resource.options.smooth);
+            if (resource.options.mipmaps && !resource.texture.generateMipmap()) {
+                LOG_WARN(Assets, "Mipmaps no disponibles");
+            }
+            resource.ready = true;
+            touch(resource);
+            resolved = true;
+        }
+        
+        // Tiempo de subida de esta textura (suma de sus franjas)
+        const sf::Time now = clock.getElapsedTime();
+        upload.timing.uploadMs += (now - elapsed).asMicroseconds() / 1000.0;
+        elapsed = now;
+        if (resource.ready) {
+            if (upload.replaces && isShared(upload.replaces, upload.path)) {
+                // Otras rutas siguen con la versión antigua: la recargada pasa
+                // a su propio recurso y la compartida no cambia
+                rekeyResource(upload.resource, upload.key);
+                auto cached = s_textureCache.find(upload.path);
+                if (cached != s_textureCache.end()) {
+                    cached->second = upload.resource;
+                }
+                auto request = s_pathRequests.find(upload.path);
+                if (request != s_pathRequests.end()) {
+                    if (auto live = request->second.lock()) {
+                        live->resource = upload.resource;
+                    }
+                }
+                LOG_INFO(Assets, "Recargada " << upload.path << " (ya no comparte textura con "
+                    << upload.replaces->label << ")");
+            } else if (upload.replaces) {
+                // Intercambio completo en la frontera del frame
+                upload.replaces->texture.swap(resource.texture);
+                upload.replaces->residentBytes = resource.residentBytes;
+                touch(*upload.replaces);
+                rekeyResource(upload.replaces, upload.key);
+                LOG_INFO(Assets, "Recargada " << upload.replaces->label);
+            }
+            recordLoadTiming(upload.timing);
+            s_uploads.pop_front();
+        }
+        
+        if (now >= budget) break;
+    }
+    
+    if (resolved) {
+        evictUnused(s_memoryBudget);
+    }
+    return resolved;
+}
+
+bool Assets::hasPendingLoads() {
+    return s_pendingDecodes > 0 || !s_uploads.empty();
+}
+
+void Assets::recordLoadTiming(const LoadTiming& timing) {
+    std::lock_guard<std::mutex> lock(s_timingMutex);
+    s_loadTimings.push_back(timing);
+}
+
+std::vector<LoadTiming> Assets::getLoadTimings() {
+    std::lock_guard<std::mutex> lock(s_timingMutex);
+    return s_loadTimings;
+}
+
+void Assets::printLoadReport(sf::Time startupTime) {
+    const std::vector<LoadTiming> timings = getLoadTimings();
+    double decodeTotal = 0.0, uploadTotal = 0.0;
+    size_t bytesTotal = 0;
+    
+    std::cout << "[Assets] Carga de assets (" << timings.size() << "):" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& timing : timings) {
+        std::cout << "  " << std::setw(8) << timing.decodeMs << " ms decodificar  "
+                  << std::setw(8) << timing.uploadMs << " ms subir  "
+                  << std::setw(7) << timing.bytes / 1024 << " KB  " << timing.label
+                  << (timing.fromCache ? " (caché)" : "") << std::endl;
+        decodeTotal += timing.decodeMs;
+        uploadTotal += timing.uploadMs;
+        bytesTotal += timing.bytes;
+    }
+    std::cout << "  total: " << decodeTotal << " ms decodificar, " << uploadTotal << " ms subir, "
+              << bytesTotal / 1024 << " KB" << std::endl;
+    std::cout << "  arranque: " << startupTime.asMicroseconds() / 1000.0 << " ms hasta tener los assets listos" << std::endl;
+    std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+bool Assets::reloadTexture(const std::string& path) {
+    std::shared_ptr<TextureResource> target;
+    auto cached = s_textureCache.find(path);
+    if (cached != s_textureCache.end()) {
+        target = cached->second;
+    } else {
+        auto key = s_pathKeys.find(path);
+        target = key != s_pathKeys.end() ? findResource(key->second) : nullptr;
+    }
+    if (!target || !target->ready) return false;
+    
+    startLoad(path, path, [path](sf::Image& image) { return image.loadFromFile(path); }, target->options, target);
+    return true;
+}
+
+bool Assets::patchTexture(const TextureHandle& handle, const sf::Image& image, sf::Vector2u position) {
+    if (!handle.isReady()) return false;
+    
+    const std::shared_ptr<TextureResource>& resource = handle.m_request->resource;
+    resource->texture.update(image, position);
+    if (resource->options.mipmaps && !resource->texture.generateMipmap()) {
+        LOG_WARN(Assets, "Mipmaps no disponibles");
+    }
+    rekeyResource(resource, 0);
+    return true;
 }
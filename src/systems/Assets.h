@@ -1,21 +1,185 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
+class ThreadPool;
+
+// Hoja de sprites lista para el atlas: frames en rejilla columns x rows, ya
+// reducidos a frameSize. sourceFrameSize es el tamaño del frame en el PNG.
+struct ScaledSheet {
+    sf::Image image;
+    unsigned int columns = 1;
+    unsigned int rows = 1;
+    sf::Vector2u sourceFrameSize;
+    sf::Vector2u frameSize;
+    bool fromCache = false;  // Leída de SCALED_CACHE_DIR sin decodificar el PNG
+};
+
+// Coste de carga de un asset: decodificación (o lectura de caché) fuera del
+// hilo principal y subida a la GPU en processUploads
+struct LoadTiming {
+    std::string label;
+    double decodeMs = 0.0;
+    double uploadMs = 0.0;
+    size_t bytes = 0;
+    bool fromCache = false;
+};
+
+struct TextureResource;
+
+// Textura cargada en segundo plano. Mientras no está lista, get() devuelve la
+// textura vacía de Assets, así que se puede dibujar desde el primer frame.
+// Cada handle vivo es una referencia: Assets no expulsa texturas referenciadas.
+class TextureHandle {
+public:
+    TextureHandle() = default;
+    
+    const sf::Texture& get() const;
+    bool isReady() const;
+    bool isFailed() const;
+    // Lista o fallida: ya no va a cambiar
+    bool isResolved() const { return isReady() || isFailed(); }
+    explicit operator bool() const { return m_request != nullptr; }
+    
+private:
+    friend class Assets;
+    struct Request;
+    std::shared_ptr<Request> m_request;
+};
+
+// Opciones de la textura al subirla a la GPU
+struct TextureOptions {
+    bool smooth = false;
+    bool mipmaps = false;
+};
+
+// Caché de texturas: cada contenido distinto (hash de los píxeles y opciones)
+// se sube una sola vez aunque lo pidan varias rutas. Las texturas sin handles
+// vivos se expulsan por LRU cuando la memoria residente supera el presupuesto.
 class Assets {
 public:
-    // Obtener textura desde archivo (con cache)
+    // Obtener textura desde archivo (con cache). El puntero es permanente: estas
+    // texturas nunca se expulsan.
     static sf::Texture* getTexture(const std::string& path);
     
     // Obtener textura vacía para inicializar sprites
     static sf::Texture* getEmptyTexture();
     
-    // Limpiar cache (opcional, para liberar memoria)
+    // Limpiar cache (opcional, para liberar memoria). Solo afecta a las
+    // texturas sin handles vivos.
     static void clearCache();
     
+    // Presupuesto de memoria de texturas (bytes residentes estimados en GPU)
+    static void setMemoryBudget(size_t bytes);
+    static size_t getResidentBytes();
+    // Texturas residentes con su tamaño, referencias y último uso
+    static void printResidencyReport();
+    
+    // FNV-1a de 64 bits (contenido de texturas y hojas)
+    static uint64_t hashBytes(const uint8_t* data, size_t size, uint64_t hash = 1469598103934665603ull);
+    
+    // Carga una hoja de columns x rows frames (rejilla del manifiesto) con
+    // cada frame reducido para que su alto no supere maxFrameHeight (0 = tamaño
+    // original). La versión reducida se guarda en SCALED_CACHE_DIR como RGBA
+    // sin comprimir y se reutiliza mientras el PNG no cambie (tamaño y fecha),
+    // evitando decodificar y reescalar al arrancar.
+    static bool loadScaledSheet(const std::string& path, unsigned int columns, unsigned int rows,
+                                unsigned int maxFrameHeight, ScaledSheet& sheet);
+    static constexpr const char* SCALED_CACHE_DIR = "cache/sprites";
+    
+    // Carga asíncrona: la decodificación corre en los hilos del pool (o en el
+    // hilo principal si no hay pool) y la subida a la GPU en processUploads,
+    // por franjas de filas dentro de un presupuesto de tiempo por frame.
+    static void setWorkerPool(ThreadPool* pool);
+    static TextureHandle getTextureAsync(const std::string& path, TextureOptions options = TextureOptions());
+    // Imagen ya decodificada (p. ej. una página de atlas): solo falta subirla.
+    // label identifica la textura en los informes.
+    static TextureHandle createTextureAsync(sf::Image image, TextureOptions options = TextureOptions(),
+                                            const std::string& label = std::string());
+    // Hilo principal, una vez por frame. Devuelve true si alguna textura quedó lista.
+    static bool processUploads(sf::Time budget);
+    static bool hasPendingLoads();
+    static constexpr unsigned int UPLOAD_ROWS = 64;  // Filas por franja de subida
+    
+    // Recarga en caliente: vuelve a decodificar path en segundo plano y, cuando
+    // la versión nueva está subida entera, la intercambia con la antigua dentro
+    // del mismo sf::Texture, así que punteros y handles siguen siendo válidos.
+    // Si otras rutas compartían esa textura por contenido, no se toca: path
+    // pasa a un recurso propio (su handle y getTexture lo ven; los punteros ya
+    // repartidos siguen en la compartida). Devuelve false si ninguna textura
+    // cargada usa esa ruta.
+    static bool reloadTexture(const std::string& path);
+    // Sobrescribe una región de una textura lista (p. ej. los frames de una
+    // página de atlas). Desde entonces no se comparte por contenido.
+    static bool patchTexture(const TextureHandle& handle, const sf::Image& image, sf::Vector2u position);
+    
+    // Tiempos de carga por asset. recordLoadTiming se puede llamar desde
+    // cualquier hilo; las texturas asíncronas se registran solas al subirse.
+    static void recordLoadTiming(const LoadTiming& timing);
+    static std::vector<LoadTiming> getLoadTimings();
+    static void printLoadReport(sf::Time startupTime);
+    
 private:
-    static std::unordered_map<std::string, std::unique_ptr<sf::Texture>> s_textureCache;
+    struct DecodedImage {
+        std::shared_ptr<TextureHandle::Request> request;
+        std::string path;
+        std::string label;
+        sf::Image image;
+        TextureOptions options;
+        uint64_t contentHash;  // Clave del recurso (contenido + opciones)
+        double decodeMs;
+        bool ok;
+        std::shared_ptr<TextureResource> replaces;  // Recarga en caliente
+    };
+    
+    struct PendingUpload {
+        std::shared_ptr<TextureResource> resource;
+        sf::Image image;
+        unsigned int nextRow = 0;
+        LoadTiming timing;
+        // Recarga: resource es una copia de trabajo que se intercambia con
+        // replaces al terminar la subida
+        std::shared_ptr<TextureResource> replaces;
+        uint64_t key = 0;
+        std::string path;  // Ruta recargada
+    };
+    
+    static ThreadPool* s_workerPool;
+    // Recursos por contenido; la caché es una referencia más
+    static std::unordered_map<uint64_t, std::shared_ptr<TextureResource>> s_resources;
+    // Texturas de getTexture (fijadas) y peticiones vivas por ruta
+    static std::unordered_map<std::string, std::shared_ptr<TextureResource>> s_textureCache;
+    static std::unordered_map<std::string, std::weak_ptr<TextureHandle::Request>> s_pathRequests;
+    static std::unordered_map<std::string, uint64_t> s_pathKeys;
+    static std::deque<PendingUpload> s_uploads;
+    static int s_pendingDecodes;
+    static size_t s_memoryBudget;
+    static uint64_t s_detachedKeys;
+    static uint64_t s_useCounter;
+    // Buzón de los hilos de decodificación
+    static std::mutex s_decodedMutex;
+    static std::vector<DecodedImage> s_decoded;
+    static std::mutex s_timingMutex;
+    static std::vector<LoadTiming> s_loadTimings;
     static std::unique_ptr<sf::Texture> s_emptyTexture;
+    
+    static TextureHandle startLoad(const std::string& path, const std::string& label, std::function<bool(sf::Image&)> decode,
+                                   TextureOptions options, std::shared_ptr<TextureResource> replaces = nullptr);
+    static uint64_t resourceKey(uint64_t contentHash, TextureOptions options);
+    static std::shared_ptr<TextureResource> findResource(uint64_t key);
+    // Cambia la clave de un recurso; 0 (o una clave ocupada) = clave única
+    // que ningún contenido puede reclamar
+    static void rekeyResource(const std::shared_ptr<TextureResource>& resource, uint64_t key);
+    // Alguna ruta distinta de path usa ese recurso
+    static bool isShared(const std::shared_ptr<TextureResource>& resource, const std::string& path);
+    static void evictUnused(size_t budget);
+    static void touch(TextureResource& resource);
+    friend class TextureHandle;
 };
@@ -0,0 +1,63 @@
+#include "systems/AsyncPlanner.h"
+#include "systems/Log.h"
+
+AsyncPlanner::~AsyncPlanner() {
+    // Espera a la decisión en curso (cancelada) antes de soltar el hilo
+    cancel();
+}
+
+void AsyncPlanner::start(DecideFunction decide, const TacticalState& root, std::shared_ptr<const Map> map,
+                         std::chrono::milliseconds deadline) {
+    cancel();
+    if (!m_pool) {
+        m_pool = std::make_unique<ThreadPool>(1);
+    }
+    
+    m_cancel = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<std::atomic<bool>> flag = m_cancel;
+    auto task = std::make_shared<std::packaged_task<std::vector<BattleCommand>()>>(
+        [decide = std::move(decide), root, map = std::move(map), flag]() {
+            return decide(root, *map, *flag);
+        });
+    m_result = task->get_future();
+    m_started = Clock::now();
+    m_deadline = m_started + deadline;
+    m_pool->submit([task]() { (*task)(); });
+}
+
+bool AsyncPlanner::poll(std::vector<BattleCommand>& plan) {
+    if (!m_result.valid()) return false;
+    
+    if (m_result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (Clock::now() >= m_deadline && !m_cancel->load(std::memory_order_relaxed)) {
+            LOG_DEBUG(Turn, "IA: plazo de decisión agotado, cancelando");
+            m_cancel->store(true, std::memory_order_relaxed);
+        }
+        return false;
+    }
+    
+    m_lastThinkMs = std::chrono::duration<double, std::milli>(Clock::now() - m_started).count();
+    m_lastCancelled = m_cancel->load(std::memory_order_relaxed);
+    plan = m_result.get();
+    m_cancel.reset();
+    return true;
+}
+
+void AsyncPlanner::cancel() {
+    if (!m_result.valid()) return;
+    // Se espera a que la decisión cancelada vuelva (enseguida): al salir, la
+    // IA ya no está en uso y el hilo principal puede reconfigurarla o usarla
+    m_cancel->store(true, std::memory_order_relaxed);
+    m_result.wait();
+    m_result = std::future<std::vector<BattleCommand>>();
+    m_cancel.reset();
+}
+
+std::shared_ptr<const Map> AsyncPlanner::snapshot(const Map& map) {
+    if (!m_snapshot || m_snapshotSource != &map || m_snapshotRevision != map.getRevision()) {
+        m_snapshot = std::make_shared<const Map>(map);
+        m_snapshotSource = &map;
+        m_snapshotRevision = map.getRevision();
+    }
+    return m_snapshot;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include "map/Map.h"
+#include "systems/Replay.h"
+#include "systems/TacticalState.h"
+#include "systems/ThreadPool.h"
+
+// Decisiones de la IA en un hilo aparte. start() recibe una foto inmutable
+// (TacticalState y una copia del Map) y el hilo principal sigue animando y
+// consulta con poll() si el plan ya está listo, sin bloquearse nunca.
+//
+// Pasado el plazo se pide cancelar: la IA devuelve enseguida su mejor jugada
+// hasta ese momento. cancel() además descarta el resultado (cambió el mapa,
+// terminó la batalla...) y espera a que la decisión vuelva, así que después
+// la IA que usaba queda libre. El hilo se crea en el primer start().
+class AsyncPlanner {
+public:
+    using DecideFunction = std::function<std::vector<BattleCommand>(const TacticalState&, const Map&,
+                                                                    const std::atomic<bool>&)>;
+    
+    AsyncPlanner() = default;
+    ~AsyncPlanner();
+    
+    AsyncPlanner(const AsyncPlanner&) = delete;
+    AsyncPlanner& operator=(const AsyncPlanner&) = delete;
+    
+    // Cancela la decisión anterior si seguía en curso. decide se ejecuta en
+    // el hilo del planificador: no debe tocar nada fuera de sus argumentos y
+    // de su propia IA.
+    void start(DecideFunction decide, const TacticalState& root, std::shared_ptr<const Map> map,
+               std::chrono::milliseconds deadline);
+    bool isThinking() const { return m_result.valid(); }
+    
+    // true (y el plan) si la decisión terminó; pide cancelar si venció el plazo
+    bool poll(std::vector<BattleCommand>& plan);
+    void cancel();
+    
+    // Foto del mapa reutilizable mientras no cambie su revisión
+    std::shared_ptr<const Map> snapshot(const Map& map);
+    
+    double getLastThinkMilliseconds() const { return m_lastThinkMs; }
+    bool wasLastCancelled() const { return m_lastCancelled; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    std::unique_ptr<ThreadPool> m_pool;
+    std::future<std::vector<BattleCommand>> m_result;
+    std::shared_ptr<std::atomic<bool>> m_cancel;
+    Clock::time_point m_started;
+    Clock::time_point m_deadline;
+    double m_lastThinkMs = 0.0;
+    bool m_lastCancelled = false;
+    
+    std::shared_ptr<const Map> m_snapshot;
+    const Map* m_snapshotSource = nullptr;
+    uint32_t m_snapshotRevision = 0;
+};
@@ -0,0 +1,105 @@
+#include "systems/Battle.h"
+#include "systems/LineOfSight.h"
+#include "systems/Spells.h"
+#include <cstdlib>
+
+Battle::Battle() {
+}
+
+bool Battle::loadMap(const MapData& data) {
+    return m_map.loadFromArray(data.width, data.height, data.blocked);
+}
+
+Entity Battle::addEntity(sf::Vector2i position, EntityType type, int team, int initiative) {
+    m_entities.emplace_back(m_store, m_store.create(position, type));
+    m_turnSystem.addEntity(m_entities.back(), team, initiative);
+    return m_entities.back();
+}
+
+void Battle::start() {
+    m_turnSystem.startGame();
+}
+
+void Battle::step() {
+    m_turnSystem.update(TurnSystem::TICK_SECONDS, m_map);
+}
+
+bool Battle::execute(const BattleCommand& command) {
+    return m_turnSystem.execute(command, m_map);
+}
+
+bool Battle::isOver() const {
+    return m_turnSystem.isBattleOver();
+}
+
+uint32_t ScriptedPlayer::nextRandom() {
+    // LCG: determinista por semilla para que las simulaciones sean repetibles
+    m_seed = m_seed * 1103515245u + 12345u;
+    return m_seed >> 16;
+}
+
+bool ScriptedPlayer::nextCommand(const Battle& battle, BattleCommand& out) {
+    const TurnSystem& turns = battle.getTurnSystem();
+    const Entity* player = turns.getCurrentEntity();
+    if (!turns.isPlayerTurn() || !player || player->isMoving()) {
+        return false;
+    }
+    
+    // Rival vivo más cercano; el resto de unidades vivas bloquea el paso
+    const auto& entities = battle.getEntities();
+    const int team = turns.getCurrentTeam();
+    const Entity* enemy = nullptr;
+    std::vector<sf::Vector2i> excluded;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        const Entity* other = &entities[i];
+        if (other == player || !other->isAlive()) continue;
+        excluded.push_back(other->getPosition());
+        if (turns.getTeam(i) == team) continue;
+        if (!enemy || LineOfSight::manhattanDistance(player->getPosition(), other->getPosition()) <
+                      LineOfSight::manhattanDistance(player->getPosition(), enemy->getPosition())) {
+            enemy = other;
+        }
+    }
+    if (!enemy) return false;
+    
+    const Map& map = battle.getMap();
+    
+    // 1) Atacar con el primer hechizo de daño que se pueda lanzar
+    const auto& spells = Spells::getPlayerSpells();
+    for (int i = 0; i < static_cast<int>(spells.size()); ++i) {
+        const Spell& spell = spells[i];
+        if (spell.effectType != EffectType::Damage) continue;
+        if (player->getRemainingPA() < spell.costPA) continue;
+        if (!LineOfSight::isInRange(player->getPosition(), enemy->getPosition(), spell.minRange, spell.maxRange)) continue;
+        if (spell.needsLoS && !LineOfSight::hasLineOfSight(map, player->getPosition(), enemy->getPosition())) continue;
+        out = BattleCommand::castSpell(i, enemy->getPosition());
+        return true;
+    }
+    
+    // 2) Acercarse al rival (desempate aleatorio entre casillas equivalentes)
+    if (player->getRemainingPM() > 0) {
+        std::vector<sf::Vector2i> tiles = Pathfinding::getReachableTiles(map, player->getPosition(), player->getRemainingPM(), excluded);
+        
+        const int startDistance = LineOfSight::manhattanDistance(player->getPosition(), enemy->getPosition());
+        int bestDistance = startDistance;
+        std::vector<sf::Vector2i> best;
+        for (const auto& tile : tiles) {
+            int distance = LineOfSight::manhattanDistance(tile, enemy->getPosition());
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best.clear();
+            }
+            if (distance == bestDistance && distance < startDistance) {
+                best.push_back(tile);
+            }
+        }
+        if (!best.empty()) {
+            out = BattleCommand::move(best[nextRandom() % best.size()]);
+            return true;
+        }
+    }
+    
+    // 3) Nada útil que hacer
+    out = BattleCommand::endTurn();
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <vector>
+#include "map/Map.h"
+#include "units/Entity.h"
+#include "systems/TurnSystem.h"
+#include "systems/Json.hpp"
+
+// Una batalla completa sin gráficos: mapa, entidades y sistema de turnos.
+// Es la unidad que simulan DofusHeadless y ReplayPlayer.
+class Battle {
+public:
+    Battle();
+    Battle(const Battle&) = delete;
+    Battle& operator=(const Battle&) = delete;
+    
+    bool loadMap(const MapData& data);
+    // team e initiative como en TurnSystem::addEntity
+    Entity addEntity(sf::Vector2i position, EntityType type, int team = -1, int initiative = 0);
+    void start();
+    
+    // Avanza un tick de TurnSystem::TICK_SECONDS
+    void step();
+    bool execute(const BattleCommand& command);
+    
+    // La batalla termina cuando solo queda un equipo con unidades vivas
+    bool isOver() const;
+    // Equipo ganador; -1 si la batalla sigue
+    int getWinningTeam() const { return m_turnSystem.getWinningTeam(); }
+    
+    Map& getMap() { return m_map; }
+    const Map& getMap() const { return m_map; }
+    TurnSystem& getTurnSystem() { return m_turnSystem; }
+    const TurnSystem& getTurnSystem() const { return m_turnSystem; }
+    const std::vector<Entity>& getEntities() const { return m_entities; }
+    const EntityStore& getStore() const { return m_store; }
+    
+private:
+    Map m_map;
+    EntityStore m_store;
+    std::vector<Entity> m_entities;
+    TurnSystem m_turnSystem;
+};
+
+// Jugador automático sencillo para simulaciones y pruebas de carga: maneja la
+// unidad de tipo Player que tenga el turno, lanza el hechizo de daño disponible
+// al rival más cercano o se acerca a él; si no puede, pasa turno.
+class ScriptedPlayer {
+public:
+    explicit ScriptedPlayer(uint32_t seed = 1) : m_seed(seed) {}
+    
+    // Devuelve false si no hay nada que ordenar este tick (no es su turno o se está moviendo)
+    bool nextCommand(const Battle& battle, BattleCommand& out);
+    
+private:
+    uint32_t m_seed;
+    uint32_t nextRandom();
+};
@@ -1,6 +1,6 @@
 #include "systems/Display.h"
 #include <algorithm>
-#include "map/Map.h"
+#include "view/MapView.h"
 
 namespace Display {
 	sf::View makeLetterboxedView(sf::Vector2u win) {
@@ -24,9 +24,14 @@ namespace Display {
 		w.setView(view);
 	}
 
-	void centerMapInView(Map& map) {
+	void centerMapInView(MapView& map) {
 		map.setCenteredOffset(sf::Vector2f(VIRTUAL_W, VIRTUAL_H));
 	}
+
+	float getDesktopScale() {
+		const sf::Vector2u desktop = sf::VideoMode::getDesktopMode().size;
+		return std::max(1.f, std::min(desktop.x / VIRTUAL_W, desktop.y / VIRTUAL_H));
+	}
 }
 
 
@@ -1,13 +1,15 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-class Map;
+class MapView;
 
 namespace Display {
     inline constexpr float VIRTUAL_W = 1280.f;
     inline constexpr float VIRTUAL_H = 720.f;
 	sf::View makeLetterboxedView(sf::Vector2u win);
 	void applyLetterbox(sf::RenderWindow& w);
-	void centerMapInView(Map& map);
+	void centerMapInView(MapView& map);
+	// Escala virtual -> píxeles a pantalla completa (el mayor tamaño posible de la ventana)
+	float getDesktopScale();
 }
 
 
@@ -0,0 +1,147 @@
+#include "systems/FileWatcher.h"
+#include <algorithm>
+#include <chrono>
+#include "systems/Log.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace {
+    constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF;
+}
+
+FileWatcher::~FileWatcher() {
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+bool FileWatcher::isActive() const {
+    return m_fd >= 0 && !m_watchDirs.empty();
+}
+
+bool FileWatcher::watch(const std::string& directory) {
+    if (m_fd < 0) {
+        m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_fd < 0) {
+            LOG_WARN(Assets, "inotify no disponible");
+            return false;
+        }
+    }
+    
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        LOG_WARN(Assets, "No existe el directorio " << directory);
+        return false;
+    }
+    
+    // inotify no es recursivo: un watch por subdirectorio
+    bool ok = addWatch(directory);
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+         it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (error) break;
+        if (it->is_directory(error)) {
+            ok = addWatch(it->path()) && ok;
+        }
+    }
+    return ok;
+}
+
+bool FileWatcher::addWatch(const std::filesystem::path& directory) {
+    const int wd = inotify_add_watch(m_fd, directory.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        LOG_WARN(Assets, "No se pudo vigilar " << directory.string());
+        return false;
+    }
+    m_watchDirs[wd] = directory.lexically_normal();
+    return true;
+}
+
+void FileWatcher::poll(std::vector<std::string>& changed) {
+    if (m_fd < 0) return;
+    
+    const size_t first = changed.size();
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        const ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) break;  // EAGAIN: no quedan eventos
+        
+        for (ssize_t offset = 0; offset < length; ) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            
+            auto dir = m_watchDirs.find(event->wd);
+            if (dir == m_watchDirs.end()) continue;
+            if (event->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+                m_watchDirs.erase(dir);
+                continue;
+            }
+            if (event->len == 0) continue;
+            
+            const std::filesystem::path path = dir->second / event->name;
+            if (event->mask & IN_ISDIR) {
+                // Directorio nuevo: vigilarlo también
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) addWatch(path);
+                continue;
+            }
+            // IN_CREATE solo no basta: el archivo aún se está escribiendo
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                const std::string name = path.generic_string();
+                if (std::find(changed.begin() + first, changed.end(), name) == changed.end()) {
+                    changed.push_back(name);
+                }
+            }
+        }
+    }
+}
+
+#else
+
+FileWatcher::~FileWatcher() = default;
+
+bool FileWatcher::isActive() const {
+    return !m_roots.empty();
+}
+
+bool FileWatcher::watch(const std::string& directory) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        LOG_WARN(Assets, "No existe el directorio " << directory);
+        return false;
+    }
+    m_roots.push_back(std::filesystem::path(directory).lexically_normal());
+    scan(nullptr);
+    return true;
+}
+
+void FileWatcher::scan(std::vector<std::string>* changed) {
+    std::error_code error;
+    for (const auto& root : m_roots) {
+        for (auto it = std::filesystem::recursive_directory_iterator(root, error);
+             it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+            if (error) break;
+            if (!it->is_regular_file(error)) continue;
+            
+            const auto time = it->last_write_time(error);
+            const std::string name = it->path().lexically_normal().generic_string();
+            auto known = m_writeTimes.find(name);
+            if (known == m_writeTimes.end() || known->second != time) {
+                if (changed) {
+                    changed->push_back(name);
+                }
+                m_writeTimes[name] = time;
+            }
+        }
+    }
+}
+
+void FileWatcher::poll(std::vector<std::string>& changed) {
+    const auto now = std::filesystem::file_time_type::clock::now();
+    if (now - m_lastScan < std::chrono::duration<float>(POLL_INTERVAL_SECONDS)) return;
+    m_lastScan = now;
+    scan(&changed);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Vigila directorios (recursivamente) y devuelve los archivos que cambiaron.
+// En Linux usa inotify sin bloquear: solo se informa de un archivo cuando su
+// escritura termina (cierre tras escribir o renombrado encima), así que nunca
+// se lee un archivo a medio guardar. En otras plataformas compara fechas de
+// modificación cada POLL_INTERVAL_SECONDS.
+class FileWatcher {
+public:
+    FileWatcher() = default;
+    ~FileWatcher();
+    
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    
+    // Rutas relativas como se pasan aquí (p. ej. "assets" -> "assets/sprites/heal.png")
+    bool watch(const std::string& directory);
+    
+    // No bloquea. Añade a changed cada archivo cambiado desde la última
+    // llamada, una sola vez aunque haya recibido varios eventos.
+    void poll(std::vector<std::string>& changed);
+    
+    bool isActive() const;
+    
+    static constexpr float POLL_INTERVAL_SECONDS = 1.0f;
+
+private:
+#ifdef __linux__
+    int m_fd = -1;
+    std::unordered_map<int, std::filesystem::path> m_watchDirs;  // wd -> directorio
+    
+    bool addWatch(const std::filesystem::path& directory);
+#else
+    std::vector<std::filesystem::path> m_roots;
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes;
+    std::filesystem::file_time_type::clock::time_point m_lastScan;
+    
+    void scan(std::vector<std::string>* changed);
+#endif
+};
@@ -1,5 +1,6 @@
 #include "systems/HUD.h"
 #include <algorithm>
+#include "systems/Profiler.h"
 
 // Definir colores estáticos
 const sf::Color HUD::HP_COLOR = sf::Color(220, 20, 20);           // Rojo
@@ -54,6 +55,7 @@ void HUD::setVirtualScale(float scale) {
 }
 
 void HUD::draw(sf::RenderTarget& target) {
+    PROFILE_ZONE("HUD::draw");
     // Dimensiones del HUD basadas en resolución virtual (1280x720)
     const float VIRTUAL_WIDTH = 1280.0f;
     const float VIRTUAL_HEIGHT = 720.0f;
@@ -0,0 +1,202 @@
+#include "systems/InfluenceMap.h"
+#include <algorithm>
+#include "systems/LineOfSight.h"
+#include "systems/Profiler.h"
+#include "systems/Spells.h"
+
+namespace {
+    bool sameContribution(const TacticalUnit& a, const TacticalUnit& b) {
+        return a.position == b.position && a.totalPM == b.totalPM && a.totalPA == b.totalPA &&
+               a.team == b.team && a.isPlayer == b.isPlayer;
+    }
+}
+
+void InfluenceMap::sync(const TacticalState& state, const Map& map) {
+    PROFILE_ZONE("InfluenceMap::sync");
+    m_lastUpdatedUnits = 0;
+    if (map.getWidth() != m_width || map.getHeight() != m_height || map.getRevision() != m_revision) {
+        // El mapa cambió: todas las aportaciones dejan de valer
+        resize(map.getWidth(), map.getHeight());
+        m_revision = map.getRevision();
+    }
+    
+    // Unidades que ya no están en la foto
+    for (size_t i = static_cast<size_t>(state.count); i < m_units.size(); ++i) {
+        if (m_units[i].active) applyUnit(m_units[i], -1);
+    }
+    m_units.resize(static_cast<size_t>(state.count));
+    
+    for (int i = 0; i < state.count; ++i) {
+        const TacticalUnit& unit = state.units[i];
+        UnitEntry& entry = m_units[i];
+        bool alive = unit.hp > 0;
+        if (entry.active == alive && (!alive || sameContribution(entry.unit, unit))) continue;
+        
+        if (entry.active) applyUnit(entry, -1);
+        entry.active = alive;
+        entry.unit = unit;
+        entry.cells.clear();
+        if (alive) {
+            computeUnit(unit, map, entry.cells);
+            applyUnit(entry, 1);
+        }
+        m_lastUpdatedUnits++;
+    }
+}
+
+void InfluenceMap::clear() {
+    m_width = 0;
+    m_height = 0;
+    m_revision = 0;
+    m_units.clear();
+    m_teams.clear();
+    m_total = Layer();
+}
+
+int InfluenceMap::getInfluence(int team, sf::Vector2i cell) const {
+    int index = indexOf(cell);
+    if (index < 0 || team < 0 || team >= static_cast<int>(m_teams.size())) return 0;
+    return m_teams[team].spells[index];
+}
+
+int InfluenceMap::getThreat(int team, sf::Vector2i cell) const {
+    int index = indexOf(cell);
+    if (index < 0) return 0;
+    int own = team >= 0 && team < static_cast<int>(m_teams.size()) ? m_teams[team].spells[index] : 0;
+    return m_total.spells[index] - own;
+}
+
+int InfluenceMap::getDamage(int team, sf::Vector2i cell) const {
+    int index = indexOf(cell);
+    if (index < 0) return 0;
+    uint32_t own = team >= 0 && team < static_cast<int>(m_teams.size()) ? m_teams[team].damage[index] : 0;
+    return static_cast<int>(m_total.damage[index] - own);
+}
+
+void InfluenceMap::resize(int width, int height) {
+    size_t size = static_cast<size_t>(width) * height;
+    m_width = width;
+    m_height = height;
+    m_units.clear();
+    for (Layer& layer : m_teams) {
+        layer.spells.assign(size, 0);
+        layer.damage.assign(size, 0);
+    }
+    m_total.spells.assign(size, 0);
+    m_total.damage.assign(size, 0);
+    
+    m_reachStamp.assign(size, 0);
+    m_spellStamp.assign(size, 0);
+    m_touchedStamp.assign(size, 0);
+    m_reachCost.assign(size, 0);
+    m_unitSpells.assign(size, 0);
+    m_unitDamage.assign(size, 0);
+    m_stamp = 0;
+}
+
+uint32_t InfluenceMap::nextStamp() {
+    if (++m_stamp == 0) {
+        std::fill(m_reachStamp.begin(), m_reachStamp.end(), 0);
+        std::fill(m_spellStamp.begin(), m_spellStamp.end(), 0);
+        std::fill(m_touchedStamp.begin(), m_touchedStamp.end(), 0);
+        m_stamp = 1;
+    }
+    return m_stamp;
+}
+
+void InfluenceMap::computeUnit(const TacticalUnit& unit, const Map& map, std::vector<CellContribution>& cells) {
+    const int width = m_width;
+    if (!map.isValidPosition(unit.position.x, unit.position.y)) return;
+    
+    // Casillas alcanzables con el PM total (BFS, coste 1 por casilla)
+    uint32_t reachStamp = nextStamp();
+    m_reach.clear();
+    m_reach.push_back(unit.position);
+    size_t start = static_cast<size_t>(unit.position.y) * width + unit.position.x;
+    m_reachStamp[start] = reachStamp;
+    m_reachCost[start] = 0;
+    static const sf::Vector2i directions[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    for (size_t head = 0; head < m_reach.size(); ++head) {
+        sf::Vector2i current = m_reach[head];
+        int cost = m_reachCost[static_cast<size_t>(current.y) * width + current.x];
+        if (cost >= unit.totalPM) continue;
+        for (sf::Vector2i direction : directions) {
+            sf::Vector2i next = current + direction;
+            if (!map.isValidPosition(next.x, next.y) || map.isBlocked(next.x, next.y)) continue;
+            size_t index = static_cast<size_t>(next.y) * width + next.x;
+            if (m_reachStamp[index] == reachStamp) continue;
+            m_reachStamp[index] = reachStamp;
+            m_reachCost[index] = cost + 1;
+            m_reach.push_back(next);
+        }
+    }
+    
+    // Casillas atacables por cada hechizo de daño desde alguna de ellas
+    uint32_t touchedStamp = nextStamp();
+    m_touched.clear();
+    const std::vector<Spell>& spells = unit.isPlayer ? Spells::getPlayerSpells() : Spells::getEnemySpells();
+    for (const Spell& spell : spells) {
+        if (spell.effectType != EffectType::Damage || spell.costPA <= 0 || spell.costPA > unit.totalPA) continue;
+        uint16_t damage = static_cast<uint16_t>(std::min(0xFFFF, spell.value * (unit.totalPA / spell.costPA)));
+        uint32_t spellStamp = nextStamp();
+        
+        for (sf::Vector2i from : m_reach) {
+            for (int dy = -spell.maxRange; dy <= spell.maxRange; ++dy) {
+                int span = spell.maxRange - std::abs(dy);
+                for (int dx = -span; dx <= span; ++dx) {
+                    sf::Vector2i cell(from.x + dx, from.y + dy);
+                    if (std::abs(dx) + std::abs(dy) < spell.minRange) continue;
+                    if (!map.isValidPosition(cell.x, cell.y) || map.isBlocked(cell.x, cell.y)) continue;
+                    size_t index = static_cast<size_t>(cell.y) * width + cell.x;
+                    if (m_spellStamp[index] == spellStamp) continue;
+                    if (spell.needsLoS && !LineOfSight::hasLineOfSight(map, from, cell)) continue;
+                    m_spellStamp[index] = spellStamp;
+                    
+                    if (m_touchedStamp[index] != touchedStamp) {
+                        m_touchedStamp[index] = touchedStamp;
+                        m_unitSpells[index] = 0;
+                        m_unitDamage[index] = 0;
+                        m_touched.push_back(static_cast<uint32_t>(index));
+                    }
+                    m_unitSpells[index]++;
+                    m_unitDamage[index] = std::max(m_unitDamage[index], damage);
+                }
+            }
+        }
+    }
+    
+    cells.reserve(m_touched.size());
+    for (uint32_t index : m_touched) {
+        cells.push_back({index, m_unitSpells[index], m_unitDamage[index]});
+    }
+}
+
+void InfluenceMap::applyUnit(const UnitEntry& entry, int sign) {
+    Layer& team = teamLayer(entry.unit.team);
+    for (const CellContribution& cell : entry.cells) {
+        team.spells[cell.index] = static_cast<uint16_t>(team.spells[cell.index] + sign * cell.spells);
+        team.damage[cell.index] += static_cast<uint32_t>(sign * cell.damage);
+        m_total.spells[cell.index] = static_cast<uint16_t>(m_total.spells[cell.index] + sign * cell.spells);
+        m_total.damage[cell.index] += static_cast<uint32_t>(sign * cell.damage);
+    }
+}
+
+InfluenceMap::Layer& InfluenceMap::teamLayer(int team) {
+    size_t index = static_cast<size_t>(std::max(team, 0));
+    if (index >= m_teams.size()) {
+        size_t size = static_cast<size_t>(m_width) * m_height;
+        m_teams.resize(index + 1);
+        for (Layer& layer : m_teams) {
+            if (layer.spells.size() != size) {
+                layer.spells.assign(size, 0);
+                layer.damage.assign(size, 0);
+            }
+        }
+    }
+    return m_teams[index];
+}
+
+int InfluenceMap::indexOf(sf::Vector2i cell) const {
+    if (cell.x < 0 || cell.y < 0 || cell.x >= m_width || cell.y >= m_height) return -1;
+    return cell.y * m_width + cell.x;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <vector>
+#include "map/Map.h"
+#include "systems/TacticalState.h"
+
+// Capas de influencia y amenaza por equipo sobre el Map. Cada unidad viva
+// aporta a las casillas que podría atacar en su próximo turno (casillas
+// alcanzables con su PM total, más el rango y la línea de visión de sus
+// hechizos de daño): cuántos de sus hechizos llegan y cuánto daño haría con
+// su PA total. Las capas de un equipo suman las aportaciones de sus unidades.
+//
+// sync() es incremental: solo recalcula las unidades que se movieron, cambiaron
+// de PM/PA o murieron (restando su aportación anterior y sumando la nueva); un
+// cambio en el mapa lo recalcula todo. Las consultas son O(1). Las demás
+// unidades no bloquean el movimiento en el cálculo: así mover una unidad solo
+// cambia su propia aportación.
+class InfluenceMap {
+public:
+    // Incorpora la foto de la batalla (las unidades se identifican por índice)
+    void sync(const TacticalState& state, const Map& map);
+    void clear();
+    
+    // Hechizos de team que alcanzan la casilla
+    int getInfluence(int team, sf::Vector2i cell) const;
+    // Hechizos de los demás equipos que alcanzan la casilla
+    int getThreat(int team, sf::Vector2i cell) const;
+    // Daño que los demás equipos podrían hacer en la casilla en un turno
+    int getDamage(int team, sf::Vector2i cell) const;
+    
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    // Unidades recalculadas en el último sync (diagnóstico)
+    int getLastUpdatedUnits() const { return m_lastUpdatedUnits; }
+
+private:
+    struct CellContribution {
+        uint32_t index;
+        uint16_t spells;
+        uint16_t damage;
+    };
+    
+    struct UnitEntry {
+        bool active = false;
+        TacticalUnit unit{};
+        std::vector<CellContribution> cells;
+    };
+    
+    struct Layer {
+        std::vector<uint16_t> spells;
+        std::vector<uint32_t> damage;
+    };
+    
+    int m_width = 0;
+    int m_height = 0;
+    uint32_t m_revision = 0;
+    std::vector<UnitEntry> m_units;
+    std::vector<Layer> m_teams;
+    Layer m_total;
+    int m_lastUpdatedUnits = 0;
+    
+    // Buffers del cálculo de una unidad, marcados por generación
+    std::vector<uint32_t> m_reachStamp;
+    std::vector<uint32_t> m_spellStamp;
+    std::vector<uint32_t> m_touchedStamp;
+    uint32_t m_stamp = 0;
+    std::vector<sf::Vector2i> m_reach;
+    std::vector<int> m_reachCost;
+    std::vector<uint32_t> m_touched;
+    std::vector<uint16_t> m_unitSpells;
+    std::vector<uint16_t> m_unitDamage;
+    
+    void resize(int width, int height);
+    uint32_t nextStamp();
+    void computeUnit(const TacticalUnit& unit, const Map& map, std::vector<CellContribution>& cells);
+    void applyUnit(const UnitEntry& entry, int sign);
+    Layer& teamLayer(int team);
+    int indexOf(sf::Vector2i cell) const;
+};
@@ -16,8 +16,4 @@ public:
     
     // Verifica si una celda está dentro del rango especificado
     static bool isInRange(sf::Vector2i from, sf::Vector2i to, int minRange, int maxRange);
-    
-private:
-    // Implementa el algoritmo de raycast tipo Bresenham
-    static std::vector<sf::Vector2i> getRaycastCells(sf::Vector2i from, sf::Vector2i to);
 };
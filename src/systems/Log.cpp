@@ -0,0 +1,229 @@
+#include "systems/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    
+    // Cola MPSC acotada (Vyukov): cada hueco lleva un número de secuencia que
+    // dice si está libre para el productor de la vuelta actual o listo para
+    // el consumidor. Los productores solo compiten en un CAS de la posición.
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        int64_t micros = 0;
+        uint32_t thread = 0;
+        LogLevel level = LogLevel::Info;
+        LogCategory category = LogCategory::Core;
+        uint16_t length = 0;
+        char text[Log::MAX_MESSAGE];
+    };
+    
+    std::atomic<uint32_t> s_nextThreadId{0};
+    
+    uint32_t currentThreadId() {
+        thread_local const uint32_t id = s_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+    
+    class Logger {
+    public:
+        Logger() : m_start(Clock::now()) {
+            for (size_t i = 0; i < Log::QUEUE_CAPACITY; ++i) {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            m_writer = std::thread(&Logger::writerLoop, this);
+        }
+        
+        ~Logger() {
+            m_stopping.store(true, std::memory_order_release);
+            m_wake.notify_one();
+            m_writer.join();
+        }
+        
+        void push(LogLevel level, LogCategory category, const char* text, size_t length) {
+            size_t position = m_enqueuePos.load(std::memory_order_relaxed);
+            Slot* slot;
+            for (;;) {
+                slot = &m_slots[position & (Log::QUEUE_CAPACITY - 1)];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                if (diff == 0) {
+                    if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);  // Llena
+                    return;
+                } else {
+                    position = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            
+            slot->micros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_start).count();
+            slot->thread = currentThreadId();
+            slot->level = level;
+            slot->category = category;
+            slot->length = static_cast<uint16_t>(std::min(length, Log::MAX_MESSAGE));
+            std::memcpy(slot->text, text, slot->length);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            
+            // Despertar al escritor solo si está dormido (notify_one no toma el mutex)
+            if (m_writerSleeping.load(std::memory_order_relaxed)) {
+                m_wake.notify_one();
+            }
+        }
+        
+        void flush() {
+            const size_t target = m_enqueuePos.load(std::memory_order_acquire);
+            while (m_writtenPos.load(std::memory_order_acquire) < target) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+        
+        uint64_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+        
+    private:
+        // Tope de espera del escritor en reposo (un aviso perdido tarda esto como mucho)
+        static constexpr auto IDLE_INTERVAL = std::chrono::milliseconds(100);
+        
+        Slot m_slots[Log::QUEUE_CAPACITY];
+        alignas(64) std::atomic<size_t> m_enqueuePos{0};
+        alignas(64) std::atomic<size_t> m_writtenPos{0};
+        std::atomic<uint64_t> m_dropped{0};
+        std::atomic<bool> m_stopping{false};
+        std::atomic<bool> m_writerSleeping{false};
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;
+        Clock::time_point m_start;
+        std::thread m_writer;
+        
+        bool hasPending() const {
+            const size_t position = m_writtenPos.load(std::memory_order_relaxed);
+            return m_slots[position & (Log::QUEUE_CAPACITY - 1)].sequence.load(std::memory_order_acquire) == position + 1;
+        }
+        
+        // Vacía lo disponible en un solo fwrite; devuelve cuántos mensajes escribió
+        size_t drain(std::string& batch) {
+            size_t position = m_writtenPos.load(std::memory_order_relaxed);
+            size_t count = 0;
+            batch.clear();
+            for (;;) {
+                Slot& slot = m_slots[position & (Log::QUEUE_CAPACITY - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != position + 1) break;
+                
+                char header[64];
+                const int headerLength = std::snprintf(header, sizeof(header), "%8.3f %s t%u [%s] ",
+                                                       slot.micros / 1000000.0, Log::getLevelName(slot.level),
+                                                       slot.thread, Log::getCategoryName(slot.category));
+                batch.append(header, static_cast<size_t>(std::max(headerLength, 0)));
+                batch.append(slot.text, slot.length);
+                batch.push_back('\n');
+                
+                slot.sequence.store(position + Log::QUEUE_CAPACITY, std::memory_order_release);
+                position++;
+                count++;
+            }
+            
+            if (count > 0) {
+                std::fwrite(batch.data(), 1, batch.size(), stdout);
+                std::fflush(stdout);
+                m_writtenPos.store(position, std::memory_order_release);
+            }
+            return count;
+        }
+        
+        void writerLoop() {
+            std::string batch;
+            batch.reserve(64 * 1024);
+            uint64_t reportedDrops = 0;
+            while (!m_stopping.load(std::memory_order_acquire)) {
+                if (drain(batch) == 0) {
+                    std::unique_lock<std::mutex> lock(m_wakeMutex);
+                    m_writerSleeping.store(true, std::memory_order_relaxed);
+                    if (!hasPending() && !m_stopping.load(std::memory_order_acquire)) {
+                        m_wake.wait_for(lock, IDLE_INTERVAL);
+                    }
+                    m_writerSleeping.store(false, std::memory_order_relaxed);
+                }
+                const uint64_t dropped = getDropped();
+                if (dropped != reportedDrops) {
+                    std::fprintf(stdout, "[Log] %llu mensajes descartados (cola llena)\n",
+                                 static_cast<unsigned long long>(dropped - reportedDrops));
+                    reportedDrops = dropped;
+                }
+            }
+            while (drain(batch) > 0) {}
+        }
+    };
+    
+    Logger& logger() {
+        static Logger instance;
+        return instance;
+    }
+    
+    uint8_t initialLevel() {
+        const char* env = std::getenv("DOFUS_LOG_LEVEL");
+        if (env) {
+            for (uint8_t level = 0; level <= static_cast<uint8_t>(LogLevel::Off); ++level) {
+                if (std::strcmp(env, Log::getLevelName(static_cast<LogLevel>(level))) == 0) return level;
+            }
+        }
+        return static_cast<uint8_t>(LogLevel::Info);
+    }
+}
+
+std::atomic<uint8_t> Log::s_minLevel{initialLevel()};
+std::atomic<uint32_t> Log::s_categoryMask{~0u};
+
+void Log::setLevel(LogLevel level) {
+    s_minLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void Log::setCategoryEnabled(LogCategory category, bool enabled) {
+    const uint32_t bit = 1u << static_cast<unsigned>(category);
+    if (enabled) {
+        s_categoryMask.fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        s_categoryMask.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+void Log::write(LogLevel level, LogCategory category, const char* text, size_t length) {
+    logger().push(level, category, text, length);
+}
+
+void Log::flush() {
+    logger().flush();
+}
+
+uint64_t Log::getDroppedCount() {
+    return logger().getDropped();
+}
+
+const char* Log::getLevelName(LogLevel level) {
+    static const char* const names[] = {"trace", "debug", "info", "warn", "error", "off"};
+    return names[static_cast<int>(level)];
+}
+
+const char* Log::getCategoryName(LogCategory category) {
+    static const char* const names[] = {"Core", "Turn", "Entity", "Spells", "Map", "App", "View", "Assets"};
+    static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(LogCategory::Count), "Falta el nombre de una categoría");
+    return names[static_cast<int>(category)];
+}
+
+LogLine::LogLine(LogLevel level, LogCategory category)
+    : std::ostream(static_cast<std::streambuf*>(this)),
+      m_level(level),
+      m_category(category) {
+    // Lo que no cabe se descarta (overflow por defecto devuelve eof)
+    setp(m_buffer, m_buffer + sizeof(m_buffer));
+}
+
+LogLine::~LogLine() {
+    Log::write(m_level, m_category, m_buffer, static_cast<size_t>(pptr() - m_buffer));
+}
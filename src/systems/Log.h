@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+
+// Log estructurado y asíncrono. Cada mensaje lleva nivel, categoría, hilo y
+// tiempo; quien lo emite solo lo formatea en un buffer de pila y lo deja en
+// una cola circular sin locks. Un hilo escritor vacía la cola por lotes y
+// vuelca a stdout una vez por lote (sin std::endl por línea). Si la cola está
+// llena el mensaje se descarta y se cuenta.
+//
+// Filtrado en dos capas:
+//   - Compilación: los niveles por debajo de DOFUS_LOG_MIN_LEVEL desaparecen
+//     del binario (if constexpr); ni siquiera se evalúan sus argumentos.
+//   - Ejecución: nivel mínimo global y máscara de categorías (una lectura
+//     atómica), configurables con la variable de entorno DOFUS_LOG_LEVEL
+//     (trace, debug, info, warn, error, off).
+//
+// Uso: LOG_DEBUG(Turn, "PA=" << pa << " PM=" << pm);
+enum class LogLevel : uint8_t { Trace, Debug, Info, Warn, Error, Off };
+
+enum class LogCategory : uint8_t { Core, Turn, Entity, Spells, Map, App, View, Assets, Count };
+
+// 0 = trace ... 5 = off. Por defecto trace/debug solo existen en builds de depuración.
+#ifndef DOFUS_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define DOFUS_LOG_MIN_LEVEL 2
+#else
+#define DOFUS_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+class Log {
+public:
+    static constexpr LogLevel COMPILED_MIN_LEVEL = static_cast<LogLevel>(DOFUS_LOG_MIN_LEVEL);
+    static constexpr size_t QUEUE_CAPACITY = 2048;  // Potencia de 2
+    static constexpr size_t MAX_MESSAGE = 240;      // Bytes por mensaje (se trunca)
+    
+    static bool isEnabled(LogLevel level, LogCategory category) {
+        return level >= static_cast<LogLevel>(s_minLevel.load(std::memory_order_relaxed)) &&
+               (s_categoryMask.load(std::memory_order_relaxed) & (1u << static_cast<unsigned>(category))) != 0;
+    }
+    
+    static void setLevel(LogLevel level);
+    static void setCategoryEnabled(LogCategory category, bool enabled);
+    
+    // Encola un mensaje ya formateado. No bloquea ni reserva memoria.
+    static void write(LogLevel level, LogCategory category, const char* text, size_t length);
+    // Espera a que el escritor haya volcado todo lo encolado hasta ahora
+    static void flush();
+    static uint64_t getDroppedCount();
+    
+    static const char* getLevelName(LogLevel level);
+    static const char* getCategoryName(LogCategory category);
+
+private:
+    static std::atomic<uint8_t> s_minLevel;
+    static std::atomic<uint32_t> s_categoryMask;
+};
+
+// Un mensaje en construcción: ostream sobre un buffer fijo en la pila
+class LogLine : private std::streambuf, public std::ostream {
+public:
+    LogLine(LogLevel level, LogCategory category);
+    ~LogLine() override;
+    
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+private:
+    LogLevel m_level;
+    LogCategory m_category;
+    char m_buffer[Log::MAX_MESSAGE];
+};
+
+#define DOFUS_LOG(level, category, message)                                                  \
+    do {                                                                                     \
+        if constexpr (LogLevel::level >= Log::COMPILED_MIN_LEVEL) {                          \
+            if (Log::isEnabled(LogLevel::level, LogCategory::category)) {                    \
+                LogLine dofusLogLine(LogLevel::level, LogCategory::category);                \
+                dofusLogLine << message;                                                     \
+            }                                                                                \
+        }                                                                                    \
+    } while (0)
+
+#define LOG_TRACE(category, message) DOFUS_LOG(Trace, category, message)
+#define LOG_DEBUG(category, message) DOFUS_LOG(Debug, category, message)
+#define LOG_INFO(category, message) DOFUS_LOG(Info, category, message)
+#define LOG_WARN(category, message) DOFUS_LOG(Warn, category, message)
+#define LOG_ERROR(category, message) DOFUS_LOG(Error, category, message)
@@ -0,0 +1,243 @@
+#include "systems/MonteCarloAI.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include "systems/Log.h"
+#include "systems/Profiler.h"
+
+namespace {
+    // Sin límite de tiempo ni de simulaciones se usa este total
+    constexpr uint64_t DEFAULT_ROLLOUTS = 1000;
+    // Escala de la puntuación de TacticalState::score en la recompensa [0, 1]
+    constexpr float SCORE_SCALE = 600.0f;
+    // Probabilidad (de 4) de que la simulación elija una jugada al azar en
+    // vez de la primera del generador (la de más valor inmediato)
+    constexpr uint32_t RANDOM_MOVE_CHANCE = 1;
+}
+
+MonteCarloAI::MonteCarloAI() : MonteCarloAI(Config()) {}
+
+MonteCarloAI::MonteCarloAI(const Config& config) {
+    setConfig(config);
+}
+
+MonteCarloAI::~MonteCarloAI() = default;
+
+void MonteCarloAI::setConfig(const Config& config) {
+    m_config = config;
+    // Los hilos y árboles se crean en el primer decide: cada TurnSystem lleva
+    // una MonteCarloAI aunque no la use
+    m_workers.clear();
+    m_pool.reset();
+}
+
+void MonteCarloAI::prepareWorkers() {
+    unsigned int threads = m_config.threads > 0 ? static_cast<unsigned int>(m_config.threads)
+                                                : std::max(1u, std::thread::hardware_concurrency());
+    if (m_workers.size() == threads) return;
+    
+    m_workers.clear();
+    for (unsigned int i = 0; i < threads; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_workers.back()->nodes.reserve(std::max<size_t>(m_config.maxNodes, 1));
+        m_workers.back()->path.reserve(64);
+    }
+    m_pool.reset();
+    if (threads > 1) {
+        m_pool = std::make_unique<ThreadPool>(threads);
+    }
+}
+
+std::vector<BattleCommand> MonteCarloAI::decide(const std::vector<Entity>& entities, size_t actor, const Map& map) {
+    if (actor >= entities.size() || actor >= static_cast<size_t>(TacticalState::MAX_UNITS)) {
+        m_stats = SearchStats();
+        return {BattleCommand::endTurn()};
+    }
+    return decide(TacticalState::fromEntities(entities, actor), map);
+}
+
+std::vector<BattleCommand> MonteCarloAI::decide(const TacticalState& root, const Map& map, const std::atomic<bool>* cancel) {
+    PROFILE_ZONE("MonteCarloAI::decide");
+    Clock::time_point start = Clock::now();
+    prepareWorkers();
+    m_stats = SearchStats();
+    m_stats.threads = static_cast<int>(m_workers.size());
+    m_cancel = cancel;
+    
+    m_root = root;
+    m_influence.sync(m_root, map);
+    m_rootTeam = m_root.units[m_root.toMove].team;
+    m_deadline = start + std::chrono::milliseconds(m_config.timeBudgetMs);
+    
+    uint64_t total = m_config.rollouts > 0 ? static_cast<uint64_t>(m_config.rollouts)
+                   : (m_config.timeBudgetMs > 0 ? std::numeric_limits<uint64_t>::max() : DEFAULT_ROLLOUTS);
+    m_rolloutsPerWorker = total == std::numeric_limits<uint64_t>::max() ? total
+                        : (total + m_workers.size() - 1) / m_workers.size();
+    
+    // Semilla por hilo y posición: distinta en cada turno pero reproducible
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        Worker& worker = *m_workers[i];
+        worker.moveGen.setMap(map);
+        worker.moveGen.setInfluence(&m_influence);
+        worker.random = (static_cast<uint64_t>(m_config.seed) << 32) ^ m_root.hash ^ ((i + 1) * 0x9E3779B97F4A7C15ull);
+        if (worker.random == 0) worker.random = 1;
+        worker.rollouts = 0;
+    }
+    
+    if (m_pool) {
+        for (auto& worker : m_workers) {
+            Worker* target = worker.get();
+            m_pool->submit([this, target]() { runWorker(*target); });
+        }
+        m_pool->waitIdle();
+    } else {
+        runWorker(*m_workers[0]);
+    }
+    
+    // Los árboles comparten el orden de las jugadas de la raíz (el generador
+    // es determinista): se suman visitas y recompensas por índice
+    const Worker& first = *m_workers[0];
+    const Node& rootNode = first.nodes[0];
+    int bestChild = -1;
+    uint64_t bestVisits = 0;
+    double bestReward = 0.0;
+    for (int i = 0; i < rootNode.childCount; ++i) {
+        uint64_t visits = 0;
+        double reward = 0.0;
+        for (const auto& worker : m_workers) {
+            const Node& child = worker->nodes[worker->nodes[0].firstChild + i];
+            visits += child.visits;
+            reward += child.reward;
+        }
+        if (bestChild < 0 || visits > bestVisits || (visits == bestVisits && reward > bestReward)) {
+            bestChild = i;
+            bestVisits = visits;
+            bestReward = reward;
+        }
+    }
+    
+    for (const auto& worker : m_workers) {
+        m_stats.rollouts += worker->rollouts;
+        m_stats.nodes += worker->nodes.size();
+    }
+    m_stats.winRate = bestVisits > 0 ? static_cast<float>(bestReward / bestVisits) : 0.0f;
+    m_stats.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    LOG_DEBUG(Turn, "IA Monte Carlo: " << m_stats.rollouts << " simulaciones en " << m_stats.threads
+              << " hilos, " << m_stats.nodes << " nodos, recompensa " << m_stats.winRate << ", "
+              << m_stats.milliseconds << " ms");
+    
+    if (bestChild < 0) return {BattleCommand::endTurn()};
+    return TacticalMoveGen::toCommands(m_root, first.nodes[rootNode.firstChild + bestChild].action);
+}
+
+void MonteCarloAI::runWorker(Worker& worker) {
+    std::vector<Node>& nodes = worker.nodes;
+    const size_t capacity = std::max<size_t>(m_config.maxNodes, 1);
+    nodes.clear();
+    nodes.emplace_back();
+    nodes[0].team = -1;
+    
+    // La raíz se expande siempre, aunque no quede presupuesto para simular
+    worker.moveGen.generate(m_root, worker.actions);
+    nodes[0].firstChild = 1;
+    nodes[0].childCount = static_cast<int>(worker.actions.size());
+    for (const TacticalAction& action : worker.actions) {
+        Node child;
+        child.action = action;
+        child.team = m_rootTeam;
+        nodes.push_back(child);
+    }
+    if (nodes[0].childCount <= 1) return;
+    
+    while (worker.rollouts < m_rolloutsPerWorker) {
+        if (m_config.timeBudgetMs > 0 && Clock::now() >= m_deadline) break;
+        if (m_cancel && m_cancel->load(std::memory_order_relaxed)) break;
+        
+        // Selección: UCT hasta una hoja o un final de batalla
+        TacticalState state = m_root;
+        worker.path.clear();
+        worker.path.push_back(0);
+        int node = 0;
+        while (nodes[node].firstChild >= 0 && state.winner() < 0) {
+            node = select(worker, node);
+            worker.path.push_back(node);
+            state = TacticalMoveGen::apply(state, nodes[node].action);
+        }
+        
+        // Expansión: todos los hijos de la hoja a la vez, si caben
+        if (state.winner() < 0) {
+            worker.moveGen.generate(state, worker.actions);
+            if (nodes.size() + worker.actions.size() <= capacity) {
+                int team = state.units[state.toMove].team;
+                nodes[node].firstChild = static_cast<int>(nodes.size());
+                nodes[node].childCount = static_cast<int>(worker.actions.size());
+                for (const TacticalAction& action : worker.actions) {
+                    Node child;
+                    child.action = action;
+                    child.team = team;
+                    nodes.push_back(child);
+                }
+                node = nodes[node].firstChild;
+                worker.path.push_back(node);
+                state = TacticalMoveGen::apply(state, nodes[node].action);
+            }
+        }
+        
+        // Simulación y retropropagación: cada nodo suma la recompensa del
+        // equipo que hizo su jugada
+        float result = rollout(worker, state);
+        for (int index : worker.path) {
+            Node& visited = nodes[index];
+            visited.visits++;
+            visited.reward += visited.team == m_rootTeam ? result : 1.0f - result;
+        }
+        worker.rollouts++;
+    }
+}
+
+int MonteCarloAI::select(const Worker& worker, int parent) const {
+    const Node& node = worker.nodes[parent];
+    const float logVisits = std::log(static_cast<float>(std::max(node.visits, 1u)));
+    int best = node.firstChild;
+    float bestValue = -1.0f;
+    for (int i = node.firstChild; i < node.firstChild + node.childCount; ++i) {
+        const Node& child = worker.nodes[i];
+        // Los hijos sin visitar primero, en el orden del generador
+        if (child.visits == 0) return i;
+        float value = child.reward / child.visits +
+                      m_config.exploration * std::sqrt(logVisits / child.visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+float MonteCarloAI::rollout(Worker& worker, TacticalState state) {
+    for (int depth = 0; depth < m_config.rolloutDepth && state.winner() < 0; ++depth) {
+        worker.moveGen.generate(state, worker.actions);
+        size_t pick = 0;
+        if (worker.actions.size() > 1 && (nextRandom(worker.random) & 3) < RANDOM_MOVE_CHANCE) {
+            pick = nextRandom(worker.random) % worker.actions.size();
+        }
+        state = TacticalMoveGen::apply(state, worker.actions[pick]);
+    }
+    return reward(state);
+}
+
+float MonteCarloAI::reward(const TacticalState& state) const {
+    // Recompensa en [0, 1] para el equipo que decide
+    int winner = state.winner();
+    if (winner >= 0) return winner == m_rootTeam ? 1.0f : 0.0f;
+    return 0.5f + 0.5f * std::tanh(state.score(m_rootTeam, m_config.aggression) / SCORE_SCALE);
+}
+
+uint32_t MonteCarloAI::nextRandom(uint64_t& state) {
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<uint32_t>((state * 0x2545F4914F6CDD1Dull) >> 32);
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "map/Map.h"
+#include "systems/InfluenceMap.h"
+#include "systems/Replay.h"
+#include "systems/TacticalState.h"
+#include "systems/ThreadPool.h"
+#include "units/Entity.h"
+
+// IA de Monte Carlo (MCTS/UCT) para batallas con varias unidades. Los nodos
+// son turnos completos de unidad (TacticalAction) y las simulaciones se
+// juegan sobre TacticalState hasta una profundidad fija.
+//
+// Paralelismo de raíz: cada hilo construye su propio árbol desde la misma
+// raíz con su propia semilla, sin compartir nada durante la búsqueda, y al
+// final se suman las visitas de cada jugada de la raíz. Los árboles y buffers
+// se reservan una vez y se reutilizan entre turnos.
+class MonteCarloAI {
+public:
+    struct Config {
+        int timeBudgetMs = 100;      // Por turno; 0 = sin límite de tiempo
+        int rollouts = 0;            // Total entre todos los hilos; 0 = sin límite
+        int threads = 0;             // 0 = hardware_concurrency
+        int rolloutDepth = 6;        // Turnos de unidad simulados desde la hoja
+        float exploration = 1.4f;    // Constante de UCT
+        size_t maxNodes = 1 << 14;   // Por árbol; al llenarse las hojas dejan de expandirse
+        int aggression = 2;          // Igual que en TacticalAI
+        uint32_t seed = 1;
+    };
+    
+    struct SearchStats {
+        uint64_t rollouts = 0;
+        uint64_t nodes = 0;
+        int threads = 0;
+        float winRate = 0.0f;        // Recompensa media de la jugada elegida
+        double milliseconds = 0.0;
+    };
+    
+    MonteCarloAI();
+    explicit MonteCarloAI(const Config& config);
+    ~MonteCarloAI();
+    
+    // Con rollouts > 0, timeBudgetMs = 0 y un número fijo de hilos la
+    // decisión es determinista
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return m_config; }
+    
+    // Plan para el turno de entities[actor], como TacticalAI::decide
+    std::vector<BattleCommand> decide(const std::vector<Entity>& entities, size_t actor, const Map& map);
+    // Desde una foto ya tomada; con *cancel activo los hilos dejan de simular
+    // y se elige con las visitas acumuladas
+    std::vector<BattleCommand> decide(const TacticalState& root, const Map& map,
+                                      const std::atomic<bool>* cancel = nullptr);
+    const SearchStats& getLastStats() const { return m_stats; }
+    const InfluenceMap& getInfluenceMap() const { return m_influence; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Node {
+        TacticalAction action;   // Jugada que lleva a este nodo
+        int team = 0;            // Equipo que hizo esa jugada
+        int firstChild = -1;     // Hijos contiguos en el árbol; -1 = sin expandir
+        int childCount = 0;
+        uint32_t visits = 0;
+        float reward = 0.0f;     // Suma de recompensas desde el punto de vista de team
+    };
+    
+    // Todo lo que usa un hilo de búsqueda
+    struct Worker {
+        TacticalMoveGen moveGen;
+        std::vector<Node> nodes;
+        std::vector<TacticalAction> actions;
+        std::vector<int> path;
+        uint64_t random = 0;
+        uint64_t rollouts = 0;
+    };
+    
+    Config m_config;
+    SearchStats m_stats;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::unique_ptr<ThreadPool> m_pool;   // Solo con más de un hilo
+    
+    // Parámetros de la búsqueda en curso (solo lectura para los hilos)
+    TacticalState m_root;
+    InfluenceMap m_influence;
+    int m_rootTeam = 0;
+    Clock::time_point m_deadline;
+    uint64_t m_rolloutsPerWorker = 0;
+    const std::atomic<bool>* m_cancel = nullptr;
+    
+    void prepareWorkers();
+    void runWorker(Worker& worker);
+    int select(const Worker& worker, int parent) const;
+    float rollout(Worker& worker, TacticalState state);
+    float reward(const TacticalState& state) const;
+    static uint32_t nextRandom(uint64_t& state);
+};
@@ -1,8 +1,10 @@
 #include "systems/Pathfinding.h"
 #include <algorithm>
 #include <iostream>
+#include "systems/Profiler.h"
 
 std::vector<sf::Vector2i> Pathfinding::getReachableTiles(const Map& map, sf::Vector2i startPos, int maxCost) {
+    PROFILE_ZONE("Pathfinding::getReachableTiles");
     std::vector<sf::Vector2i> reachableTiles;
     std::map<sf::Vector2i, int, Vec2Less> visited;
     std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
@@ -38,6 +40,7 @@ std::vector<sf::Vector2i> Pathfinding::getReachableTiles(const Map& map, sf::Vec
 }
 
 std::vector<sf::Vector2i> Pathfinding::getReachableTiles(const Map& map, sf::Vector2i startPos, int maxCost, const std::vector<sf::Vector2i>& excludedPositions) {
+    PROFILE_ZONE("Pathfinding::getReachableTiles");
     std::vector<sf::Vector2i> reachableTiles;
     std::unordered_map<sf::Vector2i, int, Vec2Hash> visited;
     std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
@@ -83,6 +86,7 @@ std::vector<sf::Vector2i> Pathfinding::getReachableTiles(const Map& map, sf::Vec
 }
 
 std::vector<sf::Vector2i> Pathfinding::findPath(const Map& map, sf::Vector2i start, sf::Vector2i end) {
+    PROFILE_ZONE("Pathfinding::findPath");
     // Algoritmo A* con heurística Manhattan
     std::priority_queue<AStarNode, std::vector<AStarNode>, std::greater<AStarNode>> openSet;
     std::unordered_map<sf::Vector2i, sf::Vector2i, Vec2Hash> parent;
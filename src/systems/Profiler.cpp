@@ -0,0 +1,155 @@
+#include "systems/Profiler.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include "systems/Log.h"
+
+std::atomic<bool> Profiler::s_enabled{false};
+thread_local bool Profiler::s_recording = false;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    
+    const Clock::time_point s_epoch = Clock::now();
+    
+    // Todo el estado lo toca solo el hilo del frame: no hace falta sincronizar
+    Profiler::Frame s_frames[Profiler::FRAME_HISTORY];
+    size_t s_current = 0;        // Hueco del frame abierto
+    size_t s_completed = 0;      // Frames completos guardados (hasta FRAME_HISTORY)
+    uint64_t s_frameIndex = 0;
+    int s_openZones[Profiler::MAX_DEPTH];
+    int s_depth = 0;
+    
+    int64_t nowUs() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - s_epoch).count();
+    }
+    
+    void closeZone(Profiler::Zone& zone, int64_t now, AllocTracker::Counters allocs) {
+        zone.durationUs = now - zone.startUs;
+        zone.allocations = allocs.count - zone.allocations;
+        zone.allocatedBytes = allocs.bytes - zone.allocatedBytes;
+    }
+    
+    void writeEscaped(std::ofstream& out, const char* text) {
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+    }
+}
+
+void Profiler::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::beginFrame() {
+    if (!isEnabled()) {
+        s_recording = false;
+        return;
+    }
+    
+    Frame& frame = s_frames[s_current];
+    frame.index = s_frameIndex++;
+    frame.startUs = nowUs();
+    frame.durationUs = 0;
+    frame.zones.clear();
+    frame.droppedZones = 0;
+    AllocTracker::Counters allocs = AllocTracker::getThreadCounters();
+    frame.allocations = allocs.count;
+    frame.allocatedBytes = allocs.bytes;
+    s_depth = 0;
+    s_recording = true;
+}
+
+void Profiler::endFrame() {
+    if (!s_recording) return;
+    s_recording = false;
+    
+    Frame& frame = s_frames[s_current];
+    int64_t now = nowUs();
+    AllocTracker::Counters allocs = AllocTracker::getThreadCounters();
+    frame.durationUs = now - frame.startUs;
+    frame.allocations = allocs.count - frame.allocations;
+    frame.allocatedBytes = allocs.bytes - frame.allocatedBytes;
+    // Zonas que siguen abiertas (return anticipado, excepción): se cierran aquí
+    while (s_depth > 0) {
+        closeZone(frame.zones[s_openZones[--s_depth]], now, allocs);
+    }
+    
+    s_current = (s_current + 1) % FRAME_HISTORY;
+    if (s_completed < FRAME_HISTORY) s_completed++;
+}
+
+int Profiler::beginZone(const char* name) {
+    Frame& frame = s_frames[s_current];
+    if (frame.zones.size() >= MAX_ZONES_PER_FRAME || s_depth >= MAX_DEPTH) {
+        frame.droppedZones++;
+        return -1;
+    }
+    
+    if (frame.zones.capacity() == 0) {
+        frame.zones.reserve(MAX_ZONES_PER_FRAME);
+    }
+    int index = static_cast<int>(frame.zones.size());
+    // Mientras está abierta, allocations guarda el contador del hilo al abrirla
+    AllocTracker::Counters allocs = AllocTracker::getThreadCounters();
+    frame.zones.push_back({name, nowUs(), 0, s_depth, allocs.count, allocs.bytes});
+    s_openZones[s_depth++] = index;
+    return index;
+}
+
+void Profiler::endZone(int zone) {
+    // La zona pudo cerrarse ya en endFrame si sobrevivió al frame
+    if (!s_recording || s_depth == 0 || s_openZones[s_depth - 1] != zone) return;
+    
+    closeZone(s_frames[s_current].zones[zone], nowUs(), AllocTracker::getThreadCounters());
+    s_depth--;
+}
+
+size_t Profiler::getFrameCount() {
+    return s_completed;
+}
+
+const Profiler::Frame& Profiler::getFrame(size_t age) {
+    return s_frames[(s_current + FRAME_HISTORY - 1 - age) % FRAME_HISTORY];
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) {
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(parent, error);
+    }
+    
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        LOG_ERROR(Core, "No se pudo escribir la traza: " << path);
+        return false;
+    }
+    
+    // Del más antiguo al más reciente; ts y dur en microsegundos
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    size_t zoneCount = 0;
+    for (size_t age = s_completed; age-- > 0;) {
+        const Frame& frame = getFrame(age);
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frame.startUs
+            << ",\"dur\":" << frame.durationUs << ",\"args\":{\"frame\":" << frame.index
+            << ",\"zonas_descartadas\":" << frame.droppedZones << ",\"reservas\":" << frame.allocations
+            << ",\"bytes_reservados\":" << frame.allocatedBytes << "}}";
+        for (const Zone& zone : frame.zones) {
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, zone.name);
+            out << "\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << zone.startUs
+                << ",\"dur\":" << zone.durationUs << ",\"args\":{\"reservas\":" << zone.allocations
+                << ",\"bytes_reservados\":" << zone.allocatedBytes << "}}";
+        }
+        zoneCount += frame.zones.size();
+    }
+    out << "\n]}\n";
+    
+    LOG_INFO(Core, "Traza exportada: " << path << " (" << s_completed << " frames, " << zoneCount << " zonas)");
+    return static_cast<bool>(out);
+}
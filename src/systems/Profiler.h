@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "systems/AllocTracker.h"
+
+// Profiler de frames con zonas anidadas (RAII). Solo registra el hilo que
+// llama a beginFrame (el bucle principal) y solo mientras está activado: en
+// cualquier otro caso una zona cuesta una lectura de un bool thread_local, así
+// que se pueden dejar en código de simulación que también corre sin ventana.
+// Los últimos FRAME_HISTORY frames se guardan en un buffer circular cuyos
+// vectores se reutilizan (sin reservas de memoria tras calentarse).
+//
+// Cada zona y cada frame anotan también las reservas de memoria del hilo
+// (ver AllocTracker; a cero si el seguimiento no está compilado).
+//
+// Uso: { PROFILE_ZONE("MapView::render"); ... }
+//      { PROFILE_ZONE_NOALLOC("SpriteBatch::draw"); ... }  // Aborta si reserva (DOFUS_ALLOC_ASSERT)
+class Profiler {
+public:
+    static constexpr size_t FRAME_HISTORY = 240;
+    static constexpr size_t MAX_ZONES_PER_FRAME = 512;  // El resto se descarta y se cuenta
+    static constexpr int MAX_DEPTH = 16;
+    
+    struct Zone {
+        const char* name;    // Literal: se guarda el puntero, no una copia
+        int64_t startUs;     // Desde el arranque del profiler
+        int64_t durationUs;
+        int depth;           // 0 = zona de primer nivel del frame
+        uint64_t allocations;     // Reservas dentro de la zona (con sus hijas)
+        uint64_t allocatedBytes;
+    };
+    
+    struct Frame {
+        uint64_t index = 0;
+        int64_t startUs = 0;
+        int64_t durationUs = 0;
+        std::vector<Zone> zones;  // En orden de apertura (padre antes que hijos)
+        uint32_t droppedZones = 0;
+        uint64_t allocations = 0;     // Del hilo del frame
+        uint64_t allocatedBytes = 0;
+    };
+    
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    
+    // Delimitan un frame en el hilo principal. Las zonas fuera de un frame se ignoran.
+    static void beginFrame();
+    static void endFrame();
+    
+    // True solo en el hilo del frame y con un frame abierto
+    static bool isRecording() { return s_recording; }
+    static int beginZone(const char* name);
+    static void endZone(int zone);
+    
+    // Frames completos; age 0 = el último
+    static size_t getFrameCount();
+    static const Frame& getFrame(size_t age);
+    
+    // Formato Trace Event de Chrome (chrome://tracing, Perfetto): un evento
+    // completo ("X") por frame y por zona
+    static bool exportChromeTrace(const std::string& path);
+
+private:
+    static std::atomic<bool> s_enabled;
+    static thread_local bool s_recording;
+};
+
+// Zona con alcance: mide desde su construcción hasta el final del bloque
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : m_zone(Profiler::isRecording() ? Profiler::beginZone(name) : -1) {}
+    ~ProfileZone() {
+        if (m_zone >= 0) Profiler::endZone(m_zone);
+    }
+    
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    int m_zone;
+};
+
+#define DOFUS_PROFILE_CONCAT_INNER(a, b) a##b
+#define DOFUS_PROFILE_CONCAT(a, b) DOFUS_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone DOFUS_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+// Zona que no debe reservar memoria. La comprobación se declara antes que la
+// zona para que se haga al final, cuando la zona ya está cerrada.
+#define PROFILE_ZONE_NOALLOC(name)                                      \
+    AllocFreeScope DOFUS_PROFILE_CONCAT(allocFreeScope_, __LINE__)(name); \
+    PROFILE_ZONE(name)
@@ -0,0 +1,273 @@
+#include "systems/Replay.h"
+#include "systems/Battle.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+namespace {
+    const char MAGIC[4] = {'D', 'L', 'R', 'P'};
+    
+    void writeU8(std::ofstream& out, uint8_t v) {
+        out.put(static_cast<char>(v));
+    }
+    
+    void writeU16(std::ofstream& out, uint16_t v) {
+        writeU8(out, static_cast<uint8_t>(v & 0xFF));
+        writeU8(out, static_cast<uint8_t>(v >> 8));
+    }
+    
+    void writeU32(std::ofstream& out, uint32_t v) {
+        writeU16(out, static_cast<uint16_t>(v & 0xFFFF));
+        writeU16(out, static_cast<uint16_t>(v >> 16));
+    }
+    
+    void writeU64(std::ofstream& out, uint64_t v) {
+        writeU32(out, static_cast<uint32_t>(v & 0xFFFFFFFFu));
+        writeU32(out, static_cast<uint32_t>(v >> 32));
+    }
+    
+    bool readU8(std::ifstream& in, uint8_t& v) {
+        char c;
+        if (!in.get(c)) return false;
+        v = static_cast<uint8_t>(c);
+        return true;
+    }
+    
+    bool readU16(std::ifstream& in, uint16_t& v) {
+        uint8_t lo, hi;
+        if (!readU8(in, lo) || !readU8(in, hi)) return false;
+        v = static_cast<uint16_t>(lo | (hi << 8));
+        return true;
+    }
+    
+    bool readU32(std::ifstream& in, uint32_t& v) {
+        uint16_t lo, hi;
+        if (!readU16(in, lo) || !readU16(in, hi)) return false;
+        v = static_cast<uint32_t>(lo) | (static_cast<uint32_t>(hi) << 16);
+        return true;
+    }
+    
+    bool readU64(std::ifstream& in, uint64_t& v) {
+        uint32_t lo, hi;
+        if (!readU32(in, lo) || !readU32(in, hi)) return false;
+        v = static_cast<uint64_t>(lo) | (static_cast<uint64_t>(hi) << 32);
+        return true;
+    }
+    
+    bool readCell(std::ifstream& in, sf::Vector2i& cell) {
+        uint16_t x, y;
+        if (!readU16(in, x) || !readU16(in, y)) return false;
+        cell = sf::Vector2i(static_cast<int16_t>(x), static_cast<int16_t>(y));
+        return true;
+    }
+    
+    void writeCell(std::ofstream& out, sf::Vector2i cell) {
+        writeU16(out, static_cast<uint16_t>(static_cast<int16_t>(cell.x)));
+        writeU16(out, static_cast<uint16_t>(static_cast<int16_t>(cell.y)));
+    }
+}
+
+bool ReplayRecorder::open(const std::string& path, const std::vector<ReplayEntity>& entities, uint8_t flags) {
+    close();
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        std::cout << "Error: No se pudo abrir el log de repetición: " << path << std::endl;
+        return false;
+    }
+    
+    m_file.write(MAGIC, sizeof(MAGIC));
+    writeU16(m_file, VERSION);
+    writeU16(m_file, static_cast<uint16_t>(entities.size()));
+    for (const auto& entity : entities) {
+        writeU8(m_file, entity.type);
+        writeCell(m_file, entity.position);
+        writeU8(m_file, static_cast<uint8_t>(static_cast<int8_t>(entity.team)));
+        writeU16(m_file, static_cast<uint16_t>(static_cast<int16_t>(entity.initiative)));
+    }
+    writeU8(m_file, flags);
+    m_file.flush();
+    return true;
+}
+
+void ReplayRecorder::close() {
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+}
+
+void ReplayRecorder::record(const BattleCommand& command) {
+    if (!m_file.is_open()) return;
+    
+    writeU8(m_file, static_cast<uint8_t>(command.type));
+    writeU32(m_file, command.tick);
+    switch (command.type) {
+        case CommandType::Move:
+        case CommandType::ToggleTile:
+            writeCell(m_file, command.cell);
+            break;
+        case CommandType::CastSpell:
+            writeU8(m_file, static_cast<uint8_t>(command.spellIndex));
+            writeCell(m_file, command.cell);
+            break;
+        default:
+            break;
+    }
+}
+
+void ReplayRecorder::recordCheckpoint(uint32_t tick, uint64_t hash) {
+    if (!m_file.is_open()) return;
+    
+    writeU8(m_file, static_cast<uint8_t>(CommandType::Checkpoint));
+    writeU32(m_file, tick);
+    writeU64(m_file, hash);
+    // Volcar en cada cambio de turno para que el log sobreviva a un crash
+    m_file.flush();
+}
+
+void ReplayRecorder::recordMap(uint32_t tick, int width, int height, const std::vector<uint8_t>& blocked) {
+    if (!m_file.is_open()) return;
+    
+    writeU8(m_file, static_cast<uint8_t>(CommandType::LoadMap));
+    writeU32(m_file, tick);
+    writeU16(m_file, static_cast<uint16_t>(width));
+    writeU16(m_file, static_cast<uint16_t>(height));
+    m_file.write(reinterpret_cast<const char*>(blocked.data()), static_cast<std::streamsize>(blocked.size()));
+    m_file.flush();
+}
+
+bool ReplayPlayer::load(const std::string& path) {
+    m_entities.clear();
+    m_records.clear();
+    m_flags = 0;
+    
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cout << "Error: No se pudo abrir la repetición: " << path << std::endl;
+        return false;
+    }
+    
+    char magic[4];
+    uint16_t version, entityCount;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, MAGIC) ||
+        !readU16(in, version) || version < ReplayRecorder::MIN_VERSION || version > ReplayRecorder::VERSION ||
+        !readU16(in, entityCount)) {
+        std::cout << "Error: Cabecera de repetición inválida: " << path << std::endl;
+        return false;
+    }
+    
+    for (uint16_t i = 0; i < entityCount; ++i) {
+        ReplayEntity entity;
+        if (!readU8(in, entity.type) || !readCell(in, entity.position)) {
+            std::cout << "Error: Repetición truncada en la cabecera" << std::endl;
+            return false;
+        }
+        if (version >= 3) {
+            uint8_t team;
+            uint16_t initiative;
+            if (!readU8(in, team) || !readU16(in, initiative)) {
+                std::cout << "Error: Repetición truncada en la cabecera" << std::endl;
+                return false;
+            }
+            entity.team = static_cast<int8_t>(team);
+            entity.initiative = static_cast<int16_t>(initiative);
+        }
+        m_entities.push_back(entity);
+    }
+    if (version >= 2 && !readU8(in, m_flags)) {
+        std::cout << "Error: Repetición truncada en la cabecera" << std::endl;
+        return false;
+    }
+    
+    uint8_t type;
+    while (readU8(in, type)) {
+        ReplayRecord record;
+        record.command.type = static_cast<CommandType>(type);
+        bool ok = readU32(in, record.command.tick);
+        
+        switch (record.command.type) {
+            case CommandType::Move:
+            case CommandType::ToggleTile:
+                ok = ok && readCell(in, record.command.cell);
+                break;
+            case CommandType::CastSpell: {
+                uint8_t spell = 0;
+                ok = ok && readU8(in, spell) && readCell(in, record.command.cell);
+                record.command.spellIndex = spell;
+                break;
+            }
+            case CommandType::EndTurn:
+                break;
+            case CommandType::Checkpoint:
+                ok = ok && readU64(in, record.hash);
+                break;
+            case CommandType::LoadMap: {
+                uint16_t w = 0, h = 0;
+                ok = ok && readU16(in, w) && readU16(in, h);
+                if (ok) {
+                    record.map.width = w;
+                    record.map.height = h;
+                    record.map.blocked.resize(static_cast<size_t>(w) * h);
+                    ok = static_cast<bool>(in.read(reinterpret_cast<char*>(record.map.blocked.data()), static_cast<std::streamsize>(record.map.blocked.size())));
+                    record.map.valid = ok;
+                }
+                break;
+            }
+            default:
+                std::cout << "Error: Tipo de registro desconocido " << static_cast<int>(type) << std::endl;
+                return false;
+        }
+        
+        if (!ok) {
+            // Un log cortado a mitad de registro (crash) se reproduce hasta el último registro completo
+            std::cout << "Aviso: Repetición truncada tras " << m_records.size() << " registros" << std::endl;
+            break;
+        }
+        m_records.push_back(record);
+    }
+    
+    return true;
+}
+
+ReplayReport ReplayPlayer::run(bool stopOnMismatch) const {
+    ReplayReport report;
+    auto startTime = std::chrono::steady_clock::now();
+    
+    Battle battle;
+    for (const auto& e : m_entities) {
+        battle.addEntity(e.position, static_cast<EntityType>(e.type), e.team, e.initiative);
+    }
+    if (m_flags & ReplayRecorder::FLAG_ENEMY_COMMANDS) {
+        battle.getTurnSystem().setEnemyAI(EnemyAI::External);
+    }
+    battle.start();
+    const TurnSystem& turnSystem = battle.getTurnSystem();
+    
+    for (const auto& record : m_records) {
+        while (turnSystem.getTick() < record.command.tick) {
+            battle.step();
+        }
+        
+        if (record.command.type == CommandType::Checkpoint) {
+            report.checkpoints++;
+            if (turnSystem.computeStateHash(battle.getMap()) != record.hash) {
+                if (report.mismatches == 0) {
+                    report.firstMismatchTick = record.command.tick;
+                }
+                report.mismatches++;
+                if (stopOnMismatch) break;
+            }
+        } else if (record.command.type == CommandType::LoadMap) {
+            battle.loadMap(record.map);
+        } else {
+            report.commands++;
+            battle.execute(record.command);
+        }
+    }
+    
+    report.ticks = turnSystem.getTick();
+    report.turns = turnSystem.getTurnCount();
+    report.finalHash = turnSystem.computeStateHash(battle.getMap());
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return report;
+}
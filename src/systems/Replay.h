@@ -0,0 +1,110 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "systems/Json.hpp"
+
+// Comandos que alteran el estado de la batalla. Son lo único que se guarda en
+// la repetición: todo lo demás (movimiento, animaciones y la IA voraz) se
+// re-simula. Los de la IA por búsqueda también se graban (FLAG_ENEMY_COMMANDS).
+enum class CommandType : uint8_t {
+    Move = 1,
+    CastSpell = 2,
+    EndTurn = 3,
+    ToggleTile = 4,
+    Checkpoint = 5,  // Hash del estado al cambiar de turno (solo en el log)
+    LoadMap = 6      // Mapa completo cargado (inicio o F5)
+};
+
+struct BattleCommand {
+    CommandType type;
+    sf::Vector2i cell;
+    int spellIndex;
+    uint32_t tick;   // Lo rellena TurnSystem al ejecutar el comando
+
+    BattleCommand(CommandType t, sf::Vector2i c = sf::Vector2i(-1, -1), int spell = -1)
+        : type(t), cell(c), spellIndex(spell), tick(0) {}
+
+    static BattleCommand move(sf::Vector2i target) { return BattleCommand(CommandType::Move, target); }
+    static BattleCommand castSpell(int spellIndex, sf::Vector2i target) { return BattleCommand(CommandType::CastSpell, target, spellIndex); }
+    static BattleCommand endTurn() { return BattleCommand(CommandType::EndTurn); }
+    static BattleCommand toggleTile(sf::Vector2i tile) { return BattleCommand(CommandType::ToggleTile, tile); }
+};
+
+// Entidad inicial de la batalla (cabecera del log)
+struct ReplayEntity {
+    uint8_t type;       // EntityType
+    sf::Vector2i position;
+    int team = -1;      // Como TurnSystem::addEntity (desde la versión 3)
+    int initiative = 0;
+};
+
+// Registro leído del log: un comando, un checkpoint o un mapa
+struct ReplayRecord {
+    BattleCommand command;
+    uint64_t hash;
+    MapData map;
+
+    ReplayRecord() : command(CommandType::EndTurn), hash(0) {}
+};
+
+// Log binario append-only. Formato (little-endian):
+//   cabecera: "DLRP" u16 versión, u16 nº entidades,
+//             {u8 tipo, i16 x, i16 y, [i8 equipo, i16 iniciativa desde la 3]}*,
+//             u8 flags (desde la versión 2)
+//   registro: u8 tipo, u32 tick, payload según tipo
+//     Move/ToggleTile: i16 x, i16 y      CastSpell: u8 hechizo, i16 x, i16 y
+//     EndTurn: -                          Checkpoint: u64 hash
+//     LoadMap: u16 ancho, u16 alto, ancho*alto bytes
+class ReplayRecorder {
+public:
+    static constexpr uint16_t VERSION = 3;
+    static constexpr uint16_t MIN_VERSION = 1;  // La 1 no tiene flags
+    // Los comandos de los enemigos están en el log: al reproducir no se ejecuta su IA
+    static constexpr uint8_t FLAG_ENEMY_COMMANDS = 1;
+
+    bool open(const std::string& path, const std::vector<ReplayEntity>& entities, uint8_t flags = 0);
+    bool isOpen() const { return m_file.is_open(); }
+    void close();
+
+    void record(const BattleCommand& command);
+    void recordCheckpoint(uint32_t tick, uint64_t hash);
+    void recordMap(uint32_t tick, int width, int height, const std::vector<uint8_t>& blocked);
+
+private:
+    std::ofstream m_file;
+};
+
+// Resultado de reproducir un log completo
+struct ReplayReport {
+    uint32_t ticks = 0;
+    int turns = 0;
+    int commands = 0;
+    int checkpoints = 0;
+    int mismatches = 0;
+    uint32_t firstMismatchTick = 0;
+    uint64_t finalHash = 0;
+    double seconds = 0.0;
+};
+
+// Reproduce un log sin ventana: reconstruye Map, entidades y TurnSystem y
+// re-ejecuta cada comando en su tick, verificando el hash en cada checkpoint.
+// Los checkpoints también marcan hasta qué tick se simula: el del final de la
+// batalla o del cierre (TurnSystem::finishRecording) cubre lo ocurrido tras
+// el último comando.
+class ReplayPlayer {
+public:
+    bool load(const std::string& path);
+    ReplayReport run(bool stopOnMismatch = true) const;
+
+    const std::vector<ReplayEntity>& getEntities() const { return m_entities; }
+    const std::vector<ReplayRecord>& getRecords() const { return m_records; }
+    uint8_t getFlags() const { return m_flags; }
+
+private:
+    std::vector<ReplayEntity> m_entities;
+    uint8_t m_flags = 0;
+    std::vector<ReplayRecord> m_records;
+};
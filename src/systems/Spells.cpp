@@ -1,21 +1,21 @@
 #include "systems/Spells.h"
-#include <iostream>
+#include "systems/Log.h"
+#include <mutex>
 
 // Definir las listas estáticas de hechizos
 std::vector<Spell> Spells::s_playerSpells;
 std::vector<Spell> Spells::s_enemySpells;
 
+// Inicialización perezosa segura entre hilos (DofusServer simula en paralelo)
+static std::once_flag s_spellsInitFlag;
+
 const std::vector<Spell>& Spells::getPlayerSpells() {
-    if (s_playerSpells.empty()) {
-        initializeSpells();
-    }
+    std::call_once(s_spellsInitFlag, initializeSpells);
     return s_playerSpells;
 }
 
 const std::vector<Spell>& Spells::getEnemySpells() {
-    if (s_enemySpells.empty()) {
-        initializeSpells();
-    }
+    std::call_once(s_spellsInitFlag, initializeSpells);
     return s_enemySpells;
 }
 
@@ -44,16 +44,16 @@ int Spells::getSpellCount() {
 void Spells::initializeSpells() {
     // Hechizos del jugador
     s_playerSpells = {
-        Spell("Golpe", 3, 1, 3, true, EffectType::Damage, 20, sf::Color::Red),
-        Spell("Flecha", 4, 2, 5, true, EffectType::Damage, 15, sf::Color::Green),
-        Spell("Curar", 2, 1, 3, true, EffectType::Heal, 15, sf::Color::Yellow)
+        Spell("Golpe", 3, 1, 3, true, EffectType::Damage, 20, 0xFF0000FF),
+        Spell("Flecha", 4, 2, 5, true, EffectType::Damage, 15, 0x00FF00FF),
+        Spell("Curar", 2, 1, 3, true, EffectType::Heal, 15, 0xFFFF00FF)
     };
     
     // Hechizos del enemigo (solo Golpe por ahora)
     s_enemySpells = {
-        Spell("Golpe", 3, 1, 3, true, EffectType::Damage, 20, sf::Color::Red)
+        Spell("Golpe", 3, 1, 3, true, EffectType::Damage, 20, 0xFF0000FF)
     };
     
-    std::cout << "Hechizos inicializados: " << s_playerSpells.size() << " para jugador, " 
-              << s_enemySpells.size() << " para enemigo" << std::endl;
+    LOG_INFO(Spells, "Hechizos inicializados: " << s_playerSpells.size() << " para jugador, " 
+        << s_enemySpells.size() << " para enemigo");
 }
@@ -1,7 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <SFML/Graphics.hpp>
 
 enum class EffectType {
     Damage,
@@ -16,9 +16,9 @@ struct Spell {
     bool needsLoS;
     EffectType effectType;
     int value;
-    sf::Color color;
+    uint32_t color;  // RGBA (la vista lo convierte con sf::Color(color))
     
-    Spell(const std::string& n, int cost, int minR, int maxR, bool los, EffectType type, int val, sf::Color col)
+    Spell(const std::string& n, int cost, int minR, int maxR, bool los, EffectType type, int val, uint32_t col)
         : name(n), costPA(cost), minRange(minR), maxRange(maxR), needsLoS(los), effectType(type), value(val), color(col) {}
 };
 
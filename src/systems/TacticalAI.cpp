@@ -0,0 +1,198 @@
+#include "systems/TacticalAI.h"
+#include <algorithm>
+#include <cstdlib>
+#include "systems/LineOfSight.h"
+#include "systems/Log.h"
+#include "systems/Pathfinding.h"
+#include "systems/Profiler.h"
+#include "systems/Spells.h"
+
+namespace {
+    constexpr int INF = 1 << 30;
+    constexpr int WIN = 1000000;          // Un equipo sin unidades vivas
+    constexpr int WIN_THRESHOLD = WIN - 1000;
+}
+
+TacticalAI::TacticalAI() : TacticalAI(Config()) {}
+
+TacticalAI::TacticalAI(const Config& config) {
+    setConfig(config);
+}
+
+void TacticalAI::setConfig(const Config& config) {
+    m_config = config;
+    // Solo se apunta el tamaño: la tabla se reserva en el primer decide(),
+    // así las partidas que nunca buscan no la pagan
+    m_tableSize = 1;
+    while (m_tableSize < std::max<size_t>(config.tableSize, 1)) m_tableSize <<= 1;
+    std::vector<TableEntry>().swap(m_table);
+    m_generation = 0;
+}
+
+std::vector<BattleCommand> TacticalAI::decide(const std::vector<Entity>& entities, size_t actor, const Map& map) {
+    if (actor >= entities.size() || actor >= static_cast<size_t>(TacticalState::MAX_UNITS)) {
+        m_stats = SearchStats();
+        return {BattleCommand::endTurn()};
+    }
+    return decide(TacticalState::fromEntities(entities, actor), map);
+}
+
+std::vector<BattleCommand> TacticalAI::decide(const TacticalState& root, const Map& map, const std::atomic<bool>* cancel) {
+    PROFILE_ZONE("TacticalAI::decide");
+    Clock::time_point start = Clock::now();
+    m_stats = SearchStats();
+    m_cancel = cancel;
+    m_influence.sync(root, map);
+    m_moveGen.setMap(map);
+    m_moveGen.setInfluence(&m_influence);
+    m_rootTeam = root.units[root.toMove].team;
+    m_deadline = start + std::chrono::milliseconds(m_config.timeBudgetMs);
+    m_aborted = false;
+    if (m_table.size() != m_tableSize) {
+        m_table.assign(m_tableSize, TableEntry());
+    }
+    m_generation++;
+    if (m_actionsByPly.size() < static_cast<size_t>(m_config.maxDepth) + 1) {
+        m_actionsByPly.resize(static_cast<size_t>(m_config.maxDepth) + 1);
+    }
+    
+    std::vector<TacticalAction>& actions = m_actionsByPly[0];
+    m_moveGen.generate(root, actions);
+    
+    // Profundización iterativa: la raíz empieza por la mejor jugada de la
+    // iteración anterior. La primera iteración siempre se completa.
+    size_t bestIndex = 0;
+    std::vector<size_t> order(actions.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    
+    for (int depth = 1; depth <= m_config.maxDepth && actions.size() > 1; ++depth) {
+        m_canAbort = depth > 1;
+        int alpha = -INF;
+        size_t iterationBest = order[0];
+        for (size_t i : order) {
+            TacticalState child = TacticalMoveGen::apply(root, actions[i]);
+            int score = search(child, depth - 1, alpha, INF, 1);
+            if (m_aborted) break;
+            if (score > alpha) {
+                alpha = score;
+                iterationBest = i;
+            }
+        }
+        if (m_aborted) break;
+        
+        bestIndex = iterationBest;
+        m_stats.depth = depth;
+        m_stats.score = alpha;
+        std::stable_partition(order.begin(), order.end(), [bestIndex](size_t i) { return i == bestIndex; });
+        if (alpha >= WIN_THRESHOLD || alpha <= -WIN_THRESHOLD) break;  // Resultado forzado
+    }
+    
+    std::vector<BattleCommand> plan = actions.empty() ? std::vector<BattleCommand>{BattleCommand::endTurn()}
+                                                      : TacticalMoveGen::toCommands(root, actions[bestIndex]);
+    
+    m_stats.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    LOG_DEBUG(Turn, "IA táctica: profundidad " << m_stats.depth << ", " << m_stats.nodes << " nodos, "
+              << m_stats.tableHits << " aciertos de tabla, puntuación " << m_stats.score << ", "
+              << m_stats.milliseconds << " ms");
+    return plan;
+}
+
+bool TacticalAI::checkBudget() {
+    if (m_aborted) return true;
+    // Cancelar corta también la primera iteración: queda la primera jugada
+    if (m_cancel && m_cancel->load(std::memory_order_relaxed)) {
+        m_aborted = true;
+        return true;
+    }
+    if (!m_canAbort) return false;
+    if (m_config.nodeBudget > 0 && m_stats.nodes >= m_config.nodeBudget) {
+        m_aborted = true;
+    } else if (m_config.timeBudgetMs > 0 && (m_stats.nodes & 63) == 0 && Clock::now() >= m_deadline) {
+        m_aborted = true;
+    }
+    return m_aborted;
+}
+
+int TacticalAI::search(const TacticalState& state, int depth, int alpha, int beta, int ply) {
+    m_stats.nodes++;
+    if (checkBudget()) return 0;  // El llamador descarta la iteración
+    
+    if (depth == 0 || state.winner() >= 0) {
+        return evaluate(state, ply);
+    }
+    
+    // Las puntuaciones de victoria dependen de la distancia a la raíz: en la
+    // tabla se guardan relativas al nodo
+    TableEntry& entry = m_table[state.hash & (m_table.size() - 1)];
+    int hint = -1;
+    if (entry.key == state.hash && entry.generation == m_generation) {
+        m_stats.tableHits++;
+        hint = entry.best;
+        if (entry.depth >= depth) {
+            int score = entry.score;
+            if (score >= WIN_THRESHOLD) score -= ply;
+            else if (score <= -WIN_THRESHOLD) score += ply;
+            if (entry.bound == Bound::Exact) return score;
+            if (entry.bound == Bound::Lower && score >= beta) return score;
+            if (entry.bound == Bound::Upper && score <= alpha) return score;
+        }
+    }
+    
+    std::vector<TacticalAction>& actions = m_actionsByPly[ply];
+    m_moveGen.generate(state, actions);
+    if (hint >= 0 && hint < static_cast<int>(actions.size()) && hint != 0) {
+        std::rotate(actions.begin(), actions.begin() + hint, actions.begin() + hint + 1);
+    }
+    
+    const bool maximizing = state.units[state.toMove].team == m_rootTeam;
+    const int alphaStart = alpha, betaStart = beta;
+    int best = maximizing ? -INF : INF;
+    int bestIndex = 0;
+    for (int i = 0; i < static_cast<int>(actions.size()); ++i) {
+        TacticalState child = TacticalMoveGen::apply(state, actions[i]);
+        int score = search(child, depth - 1, alpha, beta, ply + 1);
+        if (m_aborted) return 0;
+        
+        if (maximizing) {
+            if (score > best) {
+                best = score;
+                bestIndex = i;
+            }
+            alpha = std::max(alpha, best);
+        } else {
+            if (score < best) {
+                best = score;
+                bestIndex = i;
+            }
+            beta = std::min(beta, best);
+        }
+        if (alpha >= beta) break;
+    }
+    
+    // Índice en el orden generado (antes de adelantar la pista)
+    if (hint > 0) {
+        if (bestIndex == 0) bestIndex = hint;
+        else if (bestIndex <= hint) bestIndex -= 1;
+    }
+    
+    if (entry.generation != m_generation || entry.depth <= depth) {
+        entry.key = state.hash;
+        entry.generation = m_generation;
+        entry.depth = static_cast<int16_t>(depth);
+        entry.best = static_cast<int16_t>(bestIndex);
+        entry.bound = best <= alphaStart ? Bound::Upper : (best >= betaStart ? Bound::Lower : Bound::Exact);
+        int stored = best;
+        if (stored >= WIN_THRESHOLD) stored += ply;
+        else if (stored <= -WIN_THRESHOLD) stored -= ply;
+        entry.score = stored;
+    }
+    return best;
+}
+
+int TacticalAI::evaluate(const TacticalState& state, int ply) const {
+    // Vida de cada bando más un bonus por unidad viva, desde el equipo que
+    // decide; el término de agresividad acerca sus unidades al enemigo
+    int winner = state.winner();
+    if (winner >= 0) return winner == m_rootTeam ? WIN - ply : -WIN + ply;
+    return state.score(m_rootTeam, m_config.aggression);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "map/Map.h"
+#include "systems/InfluenceMap.h"
+#include "systems/Replay.h"
+#include "systems/TacticalState.h"
+#include "units/Entity.h"
+
+// IA táctica por búsqueda: para la unidad que juega enumera sus turnos
+// posibles (mover a una casilla alcanzable y lanzar desde ahí la mejor
+// secuencia de hechizos) y los evalúa con alpha-beta contra las respuestas de
+// las unidades siguientes en el orden de turnos. Profundización iterativa
+// dentro de un presupuesto de tiempo estricto por turno; las posiciones se
+// guardan en una tabla de transposición con claves Zobrist.
+//
+// Con varios equipos la búsqueda es paranoica: todo el que no es del equipo
+// que decide minimiza su puntuación.
+class TacticalAI {
+public:
+    struct Config {
+        int timeBudgetMs = 40;        // Por turno; 0 = sin límite de tiempo
+        uint64_t nodeBudget = 0;      // 0 = sin límite; solo con él la búsqueda es determinista
+        int maxDepth = 8;             // En turnos de unidad
+        size_t tableSize = 1 << 16;   // Entradas de la tabla de transposición (potencia de 2)
+        int aggression = 2;           // Puntos por casilla de acercamiento al enemigo más próximo
+    };
+    
+    struct SearchStats {
+        int depth = 0;          // Última profundidad completada
+        uint64_t nodes = 0;
+        uint64_t tableHits = 0;
+        int score = 0;
+        double milliseconds = 0.0;
+    };
+    
+    TacticalAI();
+    explicit TacticalAI(const Config& config);
+    
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return m_config; }
+    
+    // Plan para el turno de entities[actor]: Move opcional, CastSpell* y
+    // siempre EndTurn al final. Los comandos usan índices de Spells::getSpellByIndex.
+    std::vector<BattleCommand> decide(const std::vector<Entity>& entities, size_t actor, const Map& map);
+    // Desde una foto ya tomada (AsyncPlanner). Si *cancel se activa la
+    // búsqueda termina en cuanto lo ve con la mejor jugada hasta entonces.
+    std::vector<BattleCommand> decide(const TacticalState& root, const Map& map,
+                                      const std::atomic<bool>* cancel = nullptr);
+    const SearchStats& getLastStats() const { return m_stats; }
+    // Capas de amenaza de la última decisión (se actualizan en cada decide)
+    const InfluenceMap& getInfluenceMap() const { return m_influence; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    enum class Bound : uint8_t { Exact, Lower, Upper };
+    
+    struct TableEntry {
+        uint64_t key = 0;
+        uint32_t generation = 0;
+        int score = 0;
+        int16_t depth = -1;
+        int16_t best = -1;
+        Bound bound = Bound::Exact;
+    };
+    
+    Config m_config;
+    std::vector<TableEntry> m_table;   // Vacía hasta el primer decide()
+    size_t m_tableSize = 0;
+    uint32_t m_generation = 0;
+    SearchStats m_stats;
+    
+    // Estado de la búsqueda en curso
+    TacticalMoveGen m_moveGen;
+    InfluenceMap m_influence;
+    std::vector<std::vector<TacticalAction>> m_actionsByPly;  // Se reutilizan entre turnos
+    int m_rootTeam = 0;
+    Clock::time_point m_deadline;
+    bool m_aborted = false;
+    bool m_canAbort = false;       // La primera iteración no se corta (salvo cancelación)
+    const std::atomic<bool>* m_cancel = nullptr;
+    
+    int search(const TacticalState& state, int depth, int alpha, int beta, int ply);
+    int evaluate(const TacticalState& state, int ply) const;
+    bool checkBudget();
+};
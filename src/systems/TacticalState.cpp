@@ -0,0 +1,337 @@
+#include "systems/TacticalState.h"
+#include <algorithm>
+#include <cstdlib>
+#include "systems/InfluenceMap.h"
+#include "systems/LineOfSight.h"
+#include "systems/Spells.h"
+
+namespace {
+    constexpr int INF = 1 << 30;
+    
+    // Claves Zobrist: en vez de una tabla de números aleatorios por unidad,
+    // casilla y vida (el mapa puede medir hasta 4096x4096) cada clave se
+    // genera al vuelo con splitmix64 sobre el rasgo; el hash del estado es el
+    // XOR de las claves de sus rasgos y se actualiza incrementalmente.
+    uint64_t splitmix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+    
+    int manhattan(sf::Vector2i a, sf::Vector2i b) {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+}
+
+TacticalState TacticalState::fromEntities(const std::vector<Entity>& entities, size_t actor) {
+    TacticalState state;
+    state.count = static_cast<int>(std::min(entities.size(), static_cast<size_t>(MAX_UNITS)));
+    state.toMove = static_cast<int>(actor);
+    for (int i = 0; i < state.count; ++i) {
+        // Solo posición, recursos y tipo de cada unidad
+        const EntityStore& store = entities[i].getStore();
+        const EntityId id = entities[i].getId();
+        const EntityStore::Resources& resources = store.resources(id);
+        TacticalUnit& unit = state.units[i];
+        unit.position = store.position(id);
+        unit.hp = resources.hp;
+        unit.totalPM = resources.totalPM;
+        unit.totalPA = resources.totalPA;
+        unit.pm = resources.remainingPM;
+        unit.pa = resources.remainingPA;
+        unit.isPlayer = store.getType(id) == EntityType::Player;
+        unit.team = unit.isPlayer ? 0 : 1;
+        state.nextInOrder[i] = static_cast<int8_t>((i + 1) % state.count);
+    }
+    state.hash = computeHash(state);
+    return state;
+}
+
+void TacticalState::setTurnOrder(const std::vector<int>& order) {
+    // Las entidades que no caben en la foto se saltan
+    int first = -1, last = -1;
+    for (int index : order) {
+        if (index < 0 || index >= count) continue;
+        if (first < 0) first = index;
+        if (last >= 0) nextInOrder[last] = static_cast<int8_t>(index);
+        last = index;
+    }
+    if (last >= 0) nextInOrder[last] = static_cast<int8_t>(first);
+}
+
+int TacticalState::winner() const {
+    int team = -1;
+    for (int i = 0; i < count; ++i) {
+        if (units[i].hp <= 0) continue;
+        if (team >= 0 && units[i].team != team) return -1;
+        team = units[i].team;
+    }
+    return team;
+}
+
+int TacticalState::score(int team, int aggression) const {
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+        const TacticalUnit& unit = units[i];
+        int value = unit.hp * TacticalMoveGen::HP_WEIGHT + (unit.hp > 0 ? TacticalMoveGen::ALIVE_BONUS : 0);
+        total += unit.team == team ? value : -value;
+    }
+    
+    for (int i = 0; i < count; ++i) {
+        const TacticalUnit& unit = units[i];
+        if (unit.hp <= 0 || unit.team != team) continue;
+        int nearest = INF;
+        for (int j = 0; j < count; ++j) {
+            const TacticalUnit& other = units[j];
+            if (other.hp > 0 && other.team != team) {
+                nearest = std::min(nearest, manhattan(unit.position, other.position));
+            }
+        }
+        if (nearest != INF) total -= aggression * nearest;
+    }
+    return total;
+}
+
+uint64_t TacticalState::unitKey(int unit, sf::Vector2i position, int hp) {
+    uint64_t base = static_cast<uint64_t>(unit) << 56;
+    uint64_t cell = (static_cast<uint64_t>(static_cast<uint16_t>(position.y)) << 32) |
+                    (static_cast<uint64_t>(static_cast<uint16_t>(position.x)) << 16);
+    return splitmix(base ^ cell ^ 1) ^ splitmix(base ^ (static_cast<uint64_t>(hp) << 8) ^ 2);
+}
+
+uint64_t TacticalState::moverKey(int unit) {
+    return splitmix((static_cast<uint64_t>(unit) << 56) ^ 3);
+}
+
+uint64_t TacticalState::computeHash(const TacticalState& state) {
+    uint64_t hash = moverKey(state.toMove);
+    for (int i = 0; i < state.count; ++i) {
+        hash ^= unitKey(i, state.units[i].position, state.units[i].hp);
+    }
+    return hash;
+}
+
+void TacticalMoveGen::setMap(const Map& map) {
+    m_map = &map;
+    size_t size = static_cast<size_t>(map.getWidth()) * map.getHeight();
+    if (m_visited.size() != size) {
+        m_visited.assign(size, 0);
+        m_cost.assign(size, 0);
+        m_visitStamp = 0;
+    }
+    
+    // Hechizos por tipo de unidad, como índices globales (los que acepta execute)
+    m_spellsByType[0].clear();
+    m_spellsByType[1].clear();
+    for (int i = 0; i < Spells::getSpellCount(); ++i) {
+        m_spellsByType[0].push_back(i);
+    }
+    for (const Spell& spell : Spells::getEnemySpells()) {
+        const Spell* global = Spells::getSpellByName(spell.name);
+        if (global) {
+            m_spellsByType[1].push_back(static_cast<int>(global - Spells::getSpellByIndex(0)));
+        }
+    }
+}
+
+void TacticalMoveGen::collectReachable(const TacticalState& state) {
+    // Mismo resultado que Pathfinding::getReachableTiles con las demás
+    // unidades vivas excluidas: con coste 1 por casilla el BFS basta
+    const TacticalUnit& self = state.units[state.toMove];
+    const int width = m_map->getWidth();
+    m_tiles.clear();
+    
+    if (++m_visitStamp == 0) {
+        std::fill(m_visited.begin(), m_visited.end(), 0);
+        m_visitStamp = 1;
+    }
+    // Las casillas ocupadas se marcan visitadas de antemano (coste -1)
+    for (int i = 0; i < state.count; ++i) {
+        const TacticalUnit& other = state.units[i];
+        if (i == state.toMove || other.hp <= 0) continue;
+        if (!m_map->isValidPosition(other.position.x, other.position.y)) continue;
+        size_t index = static_cast<size_t>(other.position.y) * width + other.position.x;
+        m_visited[index] = m_visitStamp;
+        m_cost[index] = -1;
+    }
+    
+    size_t start = static_cast<size_t>(self.position.y) * width + self.position.x;
+    m_visited[start] = m_visitStamp;
+    m_cost[start] = 0;
+    m_tiles.push_back(self.position);
+    
+    static const sf::Vector2i directions[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    for (size_t head = 0; head < m_tiles.size(); ++head) {
+        sf::Vector2i current = m_tiles[head];
+        int cost = m_cost[static_cast<size_t>(current.y) * width + current.x];
+        if (cost >= self.pm) continue;
+        for (sf::Vector2i direction : directions) {
+            sf::Vector2i next = current + direction;
+            if (!m_map->isValidPosition(next.x, next.y) || m_map->isBlocked(next.x, next.y)) continue;
+            size_t index = static_cast<size_t>(next.y) * width + next.x;
+            if (m_visited[index] == m_visitStamp) continue;
+            m_visited[index] = m_visitStamp;
+            m_cost[index] = cost + 1;
+            m_tiles.push_back(next);
+        }
+    }
+}
+
+void TacticalMoveGen::generate(const TacticalState& state, std::vector<TacticalAction>& actions) {
+    actions.clear();
+    const TacticalUnit& self = state.units[state.toMove];
+    if (self.hp <= 0) {
+        // Unidad muerta: su turno pasa sin hacer nada
+        TacticalAction pass;
+        pass.destination = self.position;
+        actions.push_back(pass);
+        return;
+    }
+    
+    collectReachable(state);
+    
+    const std::vector<int>& spells = m_spellsByType[self.isPlayer ? 0 : 1];
+    Candidate candidates[TacticalState::MAX_UNITS * 4];
+    int hp[TacticalState::MAX_UNITS];
+    for (int i = 0; i < state.count; ++i) hp[i] = state.units[i].hp;
+    
+    for (sf::Vector2i tile : m_tiles) {
+        TacticalAction action;
+        action.destination = tile;
+        action.approach = INF;
+        
+        int candidateCount = 0;
+        for (int t = 0; t < state.count; ++t) {
+            const TacticalUnit& target = state.units[t];
+            if (target.hp <= 0) continue;
+            bool ally = target.team == self.team;
+            sf::Vector2i cell = t == state.toMove ? tile : target.position;
+            if (!ally) action.approach = std::min(action.approach, manhattan(tile, cell));
+            
+            int los = -1;  // Se calcula una vez por objetivo y casilla, si hace falta
+            for (int index : spells) {
+                if (candidateCount >= static_cast<int>(sizeof(candidates) / sizeof(candidates[0]))) break;
+                const Spell* spell = Spells::getSpellByIndex(index);
+                if (!spell || spell->costPA > self.pa) continue;
+                bool heal = spell->effectType == EffectType::Heal;
+                if (heal != ally) continue;
+                if (!LineOfSight::isInRange(tile, cell, spell->minRange, spell->maxRange)) continue;
+                if (spell->needsLoS) {
+                    if (los < 0) los = LineOfSight::hasLineOfSight(*m_map, tile, cell) ? 1 : 0;
+                    if (los == 0) continue;
+                }
+                candidates[candidateCount++] = {index, t, spell->costPA, spell->value, heal};
+            }
+        }
+        if (action.approach == INF) action.approach = 0;
+        if (m_influence) action.danger = m_influence->getDamage(self.team, tile);
+        
+        int sequence[TacticalAction::MAX_CASTS];
+        int bestSequence[TacticalAction::MAX_CASTS];
+        int bestLength = 0;
+        int bestGain = 0;
+        searchCasts(candidates, candidateCount, 0, self.pa, hp, sequence, 0, 0, bestGain, bestSequence, bestLength);
+        action.gain = bestGain;
+        action.castCount = bestLength;
+        for (int i = 0; i < bestLength; ++i) {
+            action.casts[i] = {candidates[bestSequence[i]].spell, candidates[bestSequence[i]].target};
+        }
+        actions.push_back(action);
+    }
+    
+    // Orden de búsqueda (y desempate en la raíz): más valor inmediato, más
+    // cerca del enemigo, menos expuesto, y por último la casilla para que sea
+    // determinista
+    std::sort(actions.begin(), actions.end(), [](const TacticalAction& a, const TacticalAction& b) {
+        if (a.gain != b.gain) return a.gain > b.gain;
+        if (a.approach != b.approach) return a.approach < b.approach;
+        if (a.danger != b.danger) return a.danger < b.danger;
+        if (a.destination.y != b.destination.y) return a.destination.y < b.destination.y;
+        return a.destination.x < b.destination.x;
+    });
+}
+
+void TacticalMoveGen::searchCasts(const Candidate* candidates, int count, int first, int pa, int* hp,
+                                  int (&sequence)[TacticalAction::MAX_CASTS], int length, int gain,
+                                  int& bestGain, int (&bestSequence)[TacticalAction::MAX_CASTS], int& bestLength) {
+    // Mejor combinación de hechizos (con repetición, sin importar el orden)
+    // para el PA disponible: maximiza el valor inmediato
+    if (gain > bestGain) {
+        bestGain = gain;
+        bestLength = length;
+        std::copy(sequence, sequence + length, bestSequence);
+    }
+    if (length == TacticalAction::MAX_CASTS) return;
+    
+    for (int i = first; i < count; ++i) {
+        const Candidate& c = candidates[i];
+        if (c.cost > pa) continue;
+        int& targetHp = hp[c.target];
+        int before = targetHp;
+        int value;
+        if (c.heal) {
+            targetHp = std::min(MAX_HP, targetHp + c.value);
+            value = (targetHp - before) * HP_WEIGHT;
+        } else {
+            targetHp = std::max(0, targetHp - c.value);
+            value = (before - targetHp) * HP_WEIGHT + (before > 0 && targetHp == 0 ? ALIVE_BONUS : 0);
+        }
+        if (value > 0) {
+            sequence[length] = i;
+            searchCasts(candidates, count, i, pa - c.cost, hp, sequence, length + 1, gain + value,
+                        bestGain, bestSequence, bestLength);
+        }
+        targetHp = before;
+    }
+}
+
+TacticalState TacticalMoveGen::apply(const TacticalState& state, const TacticalAction& action) {
+    TacticalState next = state;
+    TacticalUnit& self = next.units[next.toMove];
+    next.hash ^= TacticalState::unitKey(next.toMove, self.position, self.hp);
+    self.position = action.destination;
+    next.hash ^= TacticalState::unitKey(next.toMove, self.position, self.hp);
+    
+    for (int i = 0; i < action.castCount; ++i) {
+        const TacticalAction::Cast& cast = action.casts[i];
+        const Spell* spell = Spells::getSpellByIndex(cast.spell);
+        TacticalUnit& target = next.units[cast.target];
+        next.hash ^= TacticalState::unitKey(cast.target, target.position, target.hp);
+        if (spell->effectType == EffectType::Heal) {
+            target.hp = std::min(MAX_HP, target.hp + spell->value);
+        } else {
+            target.hp = std::max(0, target.hp - spell->value);
+        }
+        next.hash ^= TacticalState::unitKey(cast.target, target.position, target.hp);
+    }
+    
+    // Turno de la siguiente unidad viva en el orden de turnos, con PM y PA
+    // completos (Entity::startTurn)
+    next.hash ^= TacticalState::moverKey(next.toMove);
+    int following = next.nextInOrder[next.toMove];
+    for (int i = 1; i < next.count && next.units[following].hp <= 0; ++i) {
+        following = next.nextInOrder[following];
+    }
+    next.toMove = following;
+    next.hash ^= TacticalState::moverKey(next.toMove);
+    TacticalUnit& mover = next.units[next.toMove];
+    mover.pm = mover.totalPM;
+    mover.pa = mover.totalPA;
+    return next;
+}
+
+std::vector<BattleCommand> TacticalMoveGen::toCommands(const TacticalState& state, const TacticalAction& action) {
+    std::vector<BattleCommand> commands;
+    const TacticalUnit& self = state.units[state.toMove];
+    if (action.destination != self.position) {
+        commands.push_back(BattleCommand::move(action.destination));
+    }
+    for (int i = 0; i < action.castCount; ++i) {
+        const TacticalAction::Cast& cast = action.casts[i];
+        sf::Vector2i cell = cast.target == state.toMove ? action.destination : state.units[cast.target].position;
+        commands.push_back(BattleCommand::castSpell(cast.spell, cell));
+    }
+    commands.push_back(BattleCommand::endTurn());
+    return commands;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <vector>
+#include "map/Map.h"
+#include "systems/Replay.h"
+#include "units/Entity.h"
+
+class InfluenceMap;
+
+// Copia ligera de una batalla para las IA por búsqueda (TacticalAI,
+// MonteCarloAI): un array fijo de unidades que se copia con un memcpy y un
+// hash Zobrist que se actualiza incrementalmente. El turno de una unidad es
+// una TacticalAction: mover a una casilla alcanzable y lanzar desde ahí una
+// secuencia de hechizos.
+struct TacticalUnit {
+    sf::Vector2i position;
+    int hp;
+    int pm;
+    int pa;
+    int totalPM;
+    int totalPA;
+    int team;
+    bool isPlayer;
+};
+
+struct TacticalState {
+    static constexpr int MAX_UNITS = 32;
+    
+    TacticalUnit units[MAX_UNITS];
+    int8_t nextInOrder[MAX_UNITS];   // Unidad que juega después de cada una
+    int count = 0;
+    int toMove = 0;
+    uint64_t hash = 0;
+    
+    // Foto de las entidades (hasta MAX_UNITS) con entities[actor] jugando.
+    // Equipo por tipo y turnos en orden de índice; TurnSystem pone los suyos
+    static TacticalState fromEntities(const std::vector<Entity>& entities, size_t actor);
+    // order: índices de entidad en orden de turno (TurnSystem::getTurnOrder)
+    void setTurnOrder(const std::vector<int>& order);
+    
+    // Equipo con unidades vivas si solo queda uno; -1 si la batalla sigue
+    int winner() const;
+    // Vida y unidades vivas de cada bando desde team, menos aggression por
+    // casilla de distancia de cada unidad propia al enemigo más próximo
+    int score(int team, int aggression) const;
+    
+    static uint64_t unitKey(int unit, sf::Vector2i position, int hp);
+    static uint64_t moverKey(int unit);
+    static uint64_t computeHash(const TacticalState& state);
+};
+
+struct TacticalAction {
+    static constexpr int MAX_CASTS = 4;
+    
+    struct Cast {
+        int spell;   // Índice global del hechizo (Spells::getSpellByIndex)
+        int target;  // Unidad
+    };
+    
+    sf::Vector2i destination;
+    int castCount = 0;
+    Cast casts[MAX_CASTS];
+    int gain = 0;       // Valor inmediato de los hechizos (ordenación)
+    int approach = 0;   // Distancia al enemigo más próximo desde el destino
+    int danger = 0;     // Daño que el resto de equipos puede hacer en el destino (InfluenceMap)
+};
+
+// Generador de turnos sobre un mapa. Guarda sus buffers entre llamadas, así
+// que tras la primera no reserva memoria; no es seguro entre hilos (cada
+// hilo de búsqueda usa el suyo).
+class TacticalMoveGen {
+public:
+    static constexpr int MAX_HP = 100;    // Entity::takeDamage limita la curación a 100
+    static constexpr int HP_WEIGHT = 10;
+    static constexpr int ALIVE_BONUS = 500;
+    
+    // Antes de generar: dimensiona los buffers y toma los hechizos de Spells
+    void setMap(const Map& map);
+    // Capas de amenaza para desempatar destinos (opcional; deben seguir vivas
+    // y sin cambios mientras se genera)
+    void setInfluence(const InfluenceMap* influence) { m_influence = influence; }
+    
+    // Turnos posibles de state.toMove, ordenados por valor inmediato, cercanía
+    // al enemigo, peligro del destino y casilla. Una unidad muerta solo tiene el turno vacío.
+    void generate(const TacticalState& state, std::vector<TacticalAction>& actions);
+    // Aplica el turno y pasa a la siguiente unidad con PM y PA completos
+    static TacticalState apply(const TacticalState& state, const TacticalAction& action);
+    // Move opcional, CastSpell* y EndTurn
+    static std::vector<BattleCommand> toCommands(const TacticalState& state, const TacticalAction& action);
+
+private:
+    // Hechizo lanzable desde una casilla concreta
+    struct Candidate {
+        int spell;
+        int target;
+        int cost;
+        int value;
+        bool heal;
+    };
+    
+    const Map* m_map = nullptr;
+    const InfluenceMap* m_influence = nullptr;
+    std::vector<int> m_spellsByType[2];  // Hechizos de Player (0) y Enemy (1)
+    
+    // BFS de casillas alcanzables: marca por generación en vez de limpiar
+    std::vector<uint32_t> m_visited;
+    std::vector<int> m_cost;
+    uint32_t m_visitStamp = 0;
+    std::vector<sf::Vector2i> m_tiles;
+    
+    void collectReachable(const TacticalState& state);
+    static void searchCasts(const Candidate* candidates, int count, int first, int pa, int* hp,
+                            int (&sequence)[TacticalAction::MAX_CASTS], int length, int gain,
+                            int& bestGain, int (&bestSequence)[TacticalAction::MAX_CASTS], int& bestLength);
+};
@@ -0,0 +1,73 @@
+#include "systems/ThreadPool.h"
+#include <algorithm>
+
+namespace {
+    thread_local int t_workerIndex = -1;
+}
+
+ThreadPool::ThreadPool(unsigned int workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<int>(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_taskAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_taskAvailable.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_tasks.empty() && m_activeTasks == 0; });
+}
+
+int ThreadPool::currentWorkerIndex() {
+    return t_workerIndex;
+}
+
+void ThreadPool::workerLoop(int index) {
+    t_workerIndex = index;
+    
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskAvailable.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_activeTasks;
+        }
+        
+        task();
+        
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeTasks;
+            if (m_tasks.empty() && m_activeTasks == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool fijo de hilos con una cola FIFO de tareas. Las tareas no deben
+// bloquearse esperando a otras tareas del mismo pool.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int workerCount = 0); // 0 = hardware_concurrency
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    void submit(std::function<void()> task);
+    
+    // Bloquea hasta que la cola esté vacía y ningún hilo esté ejecutando tareas
+    void waitIdle();
+    
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(m_workers.size()); }
+    
+    // Índice del hilo del pool que ejecuta la llamada (-1 fuera del pool)
+    static int currentWorkerIndex();
+    
+private:
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskAvailable;
+    std::condition_variable m_idle;
+    unsigned int m_activeTasks = 0;
+    bool m_stopping = false;
+    
+    void workerLoop(int index);
+};
@@ -1,78 +1,344 @@
 #include "systems/TurnSystem.h"
 #include "systems/LineOfSight.h"
+#include "systems/Log.h"
+#include "systems/Profiler.h"
 #include <algorithm>
-#include <iostream>
 
-TurnSystem::TurnSystem() : m_currentTurn(TurnState::Player), m_currentEntityIndex(0) {
+TurnSystem::TurnSystem() : m_currentTurn(TurnState::Player), m_currentEntityIndex(0),
+                           m_tick(0), m_turnCount(0), m_checkpointTurn(0), m_recorder(nullptr) {
 }
 
-void TurnSystem::addEntity(Entity* entity) {
+void TurnSystem::addEntity(const Entity& entity, int team, int initiative) {
+    if (team < 0) {
+        team = entity.getType() == EntityType::Player ? 0 : 1;
+    }
+    int index = static_cast<int>(m_entities.size());
     m_entities.push_back(entity);
+    m_units.push_back({team, initiative, index, entity.isAlive()});
+    if (entity.getType() == EntityType::Player && m_playerIndex < 0) m_playerIndex = index;
+    if (entity.getType() == EntityType::Enemy && m_enemyIndex < 0) m_enemyIndex = index;
+    buildTurnOrder();
 }
 
 void TurnSystem::startGame() {
     if (!m_entities.empty()) {
-        m_currentEntityIndex = 0;
-        m_currentTurn = TurnState::Player;
-        m_entities[0]->startTurn();
+        buildTurnOrder();
+        setCurrent(0);
+        m_entities[m_currentEntityIndex].startTurn();
+    }
+}
+
+void TurnSystem::buildTurnOrder() {
+    // Iniciativa descendente; el orden de alta desempata (orden estable)
+    const size_t count = m_entities.size();
+    m_turnOrder.resize(count);
+    for (size_t i = 0; i < count; ++i) m_turnOrder[i] = static_cast<int>(i);
+    std::stable_sort(m_turnOrder.begin(), m_turnOrder.end(), [this](int a, int b) {
+        return m_units[a].initiative > m_units[b].initiative;
+    });
+    
+    m_teamAlive.clear();
+    m_teamsAlive = 0;
+    for (size_t i = 0; i < count; ++i) {
+        UnitInfo& unit = m_units[m_turnOrder[i]];
+        unit.orderPosition = static_cast<int>(i);
+        unit.alive = m_entities[m_turnOrder[i]].isAlive();
+        if (unit.team >= static_cast<int>(m_teamAlive.size())) m_teamAlive.resize(unit.team + 1, 0);
+        if (unit.alive && m_teamAlive[unit.team]++ == 0) m_teamsAlive++;
+    }
+    
+    // Enlaces entre posiciones vivas consecutivas (circular)
+    m_orderNext.assign(count, 0);
+    m_orderPrev.assign(count, 0);
+    int first = -1, last = -1;
+    for (size_t i = 0; i < count; ++i) {
+        if (!m_units[m_turnOrder[i]].alive) continue;
+        int position = static_cast<int>(i);
+        if (first < 0) first = position;
+        if (last >= 0) {
+            m_orderNext[last] = position;
+            m_orderPrev[position] = last;
+        }
+        last = position;
+    }
+    if (first >= 0) {
+        m_orderNext[last] = first;
+        m_orderPrev[first] = last;
+    }
+    
+    if (m_currentEntityIndex < static_cast<int>(count)) {
+        m_orderPosition = m_units[m_currentEntityIndex].orderPosition;
+    }
+}
+
+void TurnSystem::setCurrent(int orderPosition) {
+    m_orderPosition = orderPosition;
+    m_currentEntityIndex = m_turnOrder[orderPosition];
+    m_currentTurn = m_entities[m_currentEntityIndex].getType() == EntityType::Player ? TurnState::Player
+                                                                                        : TurnState::Enemy;
+}
+
+void TurnSystem::refreshUnit(int index) {
+    UnitInfo& unit = m_units[index];
+    bool alive = m_entities[index].isAlive();
+    if (alive == unit.alive) return;
+    unit.alive = alive;
+    int position = unit.orderPosition;
+    
+    if (!alive) {
+        LOG_DEBUG(Turn, "Unidad " << index << " (equipo " << unit.team << ") fuera de combate");
+        if (--m_teamAlive[unit.team] == 0) m_teamsAlive--;
+        // Sus propios enlaces se conservan: si era la unidad actual, nextTurn
+        // sigue desde ella hasta la siguiente viva
+        m_orderNext[m_orderPrev[position]] = m_orderNext[position];
+        m_orderPrev[m_orderNext[position]] = m_orderPrev[position];
+        return;
+    }
+    
+    // Revivir es raro: se busca la unidad viva anterior en el orden
+    if (m_teamAlive[unit.team]++ == 0) m_teamsAlive++;
+    const int count = static_cast<int>(m_turnOrder.size());
+    int previous = -1;
+    for (int step = 1; step < count; ++step) {
+        int candidate = (position - step + count) % count;
+        if (m_units[m_turnOrder[candidate]].alive) {
+            previous = candidate;
+            break;
+        }
+    }
+    if (previous < 0) {
+        m_orderNext[position] = position;
+        m_orderPrev[position] = position;
+        return;
+    }
+    m_orderNext[position] = m_orderNext[previous];
+    m_orderPrev[position] = previous;
+    m_orderPrev[m_orderNext[previous]] = position;
+    m_orderNext[previous] = position;
+}
+
+int TurnSystem::findNearestOpponent(int index) const {
+    const int team = m_units[index].team;
+    const sf::Vector2i from = m_entities[index].getPosition();
+    int best = -1;
+    int bestDistance = 0;
+    for (size_t i = 0; i < m_entities.size(); ++i) {
+        if (m_units[i].team == team || !m_entities[i].isAlive()) continue;
+        int distance = LineOfSight::manhattanDistance(from, m_entities[i].getPosition());
+        if (best < 0 || distance < bestDistance) {
+            best = static_cast<int>(i);
+            bestDistance = distance;
+        }
     }
+    return best;
+}
+
+TacticalState TurnSystem::snapshotState() const {
+    TacticalState state = TacticalState::fromEntities(m_entities, m_currentEntityIndex);
+    for (int i = 0; i < state.count; ++i) {
+        state.units[i].team = m_units[i].team;
+    }
+    state.setTurnOrder(m_turnOrder);
+    return state;
 }
 
 void TurnSystem::endCurrentTurn() {
     if (m_currentEntityIndex < m_entities.size()) {
-        m_entities[m_currentEntityIndex]->endTurn();
+        m_entities[m_currentEntityIndex].endTurn();
     }
     nextTurn();
 }
 
 void TurnSystem::update(float deltaTime, const Map& map) {
+    PROFILE_ZONE("TurnSystem::update");
+    ++m_tick;
     if (m_entities.empty()) return;
     
     // Actualizar la entidad actual
     if (m_currentEntityIndex < m_entities.size()) {
-        m_entities[m_currentEntityIndex]->update(deltaTime);
+        m_entities[m_currentEntityIndex].update(deltaTime);
         
         // Si es el turno del enemigo y no se está moviendo, ejecutar IA
-        if (isEnemyTurn() && !m_entities[m_currentEntityIndex]->isMoving()) {
+        if (isEnemyTurn() && !m_entities[m_currentEntityIndex].isMoving()) {
             // Verificar si el enemy terminó su animación de combate
-            if (m_entities[m_currentEntityIndex]->isPlayingCombatAnimation()) {
+            if (m_entities[m_currentEntityIndex].isPlayingCombatAnimation()) {
                 // Esperar a que termine la animación
-                std::cout << "Enemy en animación de combate, esperando..." << std::endl;
+                LOG_TRACE(Turn, "Enemy en animación de combate, esperando...");
             } else {
                 // Ejecutar IA normal
                 executeEnemyAI(map);
             }
         }
     }
+    
+    // Checkpoint al final del tick en que cambió el turno o terminó la batalla
+    // (lo que la IA voraz hace tras el último comando también se verifica)
+    const bool battleEnded = isBattleOver() && !m_endCheckpointed;
+    if (m_recorder && (m_turnCount != m_checkpointTurn || battleEnded)) {
+        m_recorder->recordCheckpoint(m_tick, computeStateHash(map));
+        m_checkpointTurn = m_turnCount;
+        m_endCheckpointed = isBattleOver();
+    }
+}
+
+bool TurnSystem::execute(const BattleCommand& command, Map& map) {
+    if (!getCurrentEntity()) return false;
+    
+    if (command.type == CommandType::ToggleTile) {
+        if (!map.isValidPosition(command.cell.x, command.cell.y)) return false;
+        if (m_recorder) {
+            BattleCommand stamped = command;
+            stamped.tick = m_tick;
+            m_recorder->record(stamped);
+        }
+        map.toggleTile(command.cell.x, command.cell.y);
+        return true;
+    }
+    return applyCommand(command, map);
+}
+
+bool TurnSystem::applyCommand(const BattleCommand& command, const Map& map) {
+    Entity* actor = getCurrentEntity();
+    if (!actor) return false;
+    
+    BattleCommand stamped = command;
+    stamped.tick = m_tick;
+    
+    switch (command.type) {
+        case CommandType::Move:
+            if (actor->isMoving()) return false;
+            if (m_recorder) m_recorder->record(stamped);
+            actor->moveTo(command.cell, map);
+            return true;
+            
+        case CommandType::CastSpell: {
+            const Spell* spell = Spells::getSpellByIndex(command.spellIndex);
+            if (!spell) return false;
+            
+            // Las unidades fuera de combate no son objetivo (otra puede estar en su casilla)
+            int targetIndex = -1;
+            for (size_t i = 0; i < m_entities.size(); ++i) {
+                if (static_cast<int>(i) != m_currentEntityIndex && m_entities[i].isAlive() &&
+                    m_entities[i].getPosition() == command.cell) {
+                    targetIndex = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (targetIndex < 0) return false;
+            
+            if (m_recorder) m_recorder->record(stamped);
+            // Animaciones: 0=ataqueespadaa (Golpe), 1=ataquearco (Flecha), 2=heal (Curar)
+            actor->startCombatAnimation(command.spellIndex);
+            bool cast = actor->castSpell(*spell, command.cell, map, m_entities[targetIndex]);
+            refreshUnit(targetIndex);
+            return cast;
+        }
+            
+        case CommandType::EndTurn:
+            if (m_recorder) m_recorder->record(stamped);
+            endCurrentTurn();
+            return true;
+            
+        default:
+            return false;
+    }
+}
+
+void TurnSystem::finishRecording(const Map& map) {
+    if (!m_recorder) return;
+    // Checkpoint final: la repetición avanza hasta este tick y lo verifica
+    m_recorder->recordCheckpoint(m_tick, computeStateHash(map));
+    m_recorder->close();
+    m_recorder = nullptr;
+}
+
+uint64_t TurnSystem::computeStateHash(const Map& map) const {
+    PROFILE_ZONE_NOALLOC("TurnSystem::computeStateHash");
+    // FNV-1a de 64 bits sobre el estado de juego (no incluye estado visual)
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](int value) {
+        uint32_t v = static_cast<uint32_t>(value);
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (v >> (i * 8)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    };
+    
+    mix(static_cast<int>(m_currentTurn));
+    mix(m_currentEntityIndex);
+    // Solo los componentes de posición, recursos y camino de cada unidad
+    for (const Entity& entity : m_entities) {
+        const EntityStore& store = entity.getStore();
+        const EntityId id = entity.getId();
+        const sf::Vector2i position = store.position(id);
+        const EntityStore::Resources& resources = store.resources(id);
+        mix(position.x);
+        mix(position.y);
+        mix(resources.hp);
+        mix(resources.remainingPA);
+        mix(resources.remainingPM);
+        mix(store.path(id).remaining());
+    }
+    // Mismo orden que exportBlockedLinear, sin copiar el mapa
+    for (int y = 0; y < map.getHeight(); ++y) {
+        for (int x = 0; x < map.getWidth(); ++x) {
+            mix(map.isBlocked(x, y) ? 1 : 0);
+        }
+    }
+    return hash;
 }
 
 TurnState TurnSystem::getCurrentTurn() const {
     return m_currentTurn;
 }
 
-Entity* TurnSystem::getCurrentEntity() const {
-    if (m_currentEntityIndex < m_entities.size()) {
-        return m_entities[m_currentEntityIndex];
+Entity* TurnSystem::getCurrentEntity() {
+    if (m_currentEntityIndex < static_cast<int>(m_entities.size())) {
+        return &m_entities[m_currentEntityIndex];
     }
     return nullptr;
 }
 
-Entity* TurnSystem::getPlayer() const {
-    for (auto* entity : m_entities) {
-        if (entity->getType() == EntityType::Player) {
-            return entity;
-        }
+const Entity* TurnSystem::getCurrentEntity() const {
+    if (m_currentEntityIndex < static_cast<int>(m_entities.size())) {
+        return &m_entities[m_currentEntityIndex];
     }
     return nullptr;
 }
 
-Entity* TurnSystem::getEnemy() const {
-    for (auto* entity : m_entities) {
-        if (entity->getType() == EntityType::Enemy) {
-            return entity;
-        }
+int TurnSystem::getCurrentTeam() const {
+    if (m_currentEntityIndex < static_cast<int>(m_units.size())) {
+        return m_units[m_currentEntityIndex].team;
     }
-    return nullptr;
+    return -1;
+}
+
+Entity* TurnSystem::getPlayer() {
+    return m_playerIndex >= 0 ? &m_entities[m_playerIndex] : nullptr;
+}
+
+const Entity* TurnSystem::getPlayer() const {
+    return m_playerIndex >= 0 ? &m_entities[m_playerIndex] : nullptr;
+}
+
+Entity* TurnSystem::getEnemy() {
+    return m_enemyIndex >= 0 ? &m_entities[m_enemyIndex] : nullptr;
+}
+
+const Entity* TurnSystem::getEnemy() const {
+    return m_enemyIndex >= 0 ? &m_entities[m_enemyIndex] : nullptr;
+}
+
+int TurnSystem::getWinningTeam() const {
+    if (m_teamsAlive != 1) return -1;
+    for (size_t team = 0; team < m_teamAlive.size(); ++team) {
+        if (m_teamAlive[team] > 0) return static_cast<int>(team);
+    }
+    return -1;
+}
+
+int TurnSystem::getAliveCount(int team) const {
+    return team >= 0 && team < static_cast<int>(m_teamAlive.size()) ? m_teamAlive[team] : 0;
 }
 
 bool TurnSystem::isPlayerTurn() const {
@@ -84,27 +350,49 @@ bool TurnSystem::isEnemyTurn() const {
 }
 
 void TurnSystem::nextTurn() {
-    m_currentEntityIndex = (m_currentEntityIndex + 1) % m_entities.size();
-    m_currentTurn = (m_currentTurn == TurnState::Player) ? TurnState::Enemy : TurnState::Player;
-    
-    if (m_currentEntityIndex < m_entities.size()) {
-        m_entities[m_currentEntityIndex]->startTurn();
+    if (m_entities.empty()) return;
+    if (isBattleOver()) {
+        // Nadie contra quien jugar: el turno avanza sin saltar a nadie
+        setCurrent((m_orderPosition + 1) % static_cast<int>(m_turnOrder.size()));
+    } else {
+        // Siguiente viva. Si la actual murió sus enlaces siguen apuntando
+        // hacia delante: basta seguirlos hasta una viva
+        int position = m_orderNext[m_orderPosition];
+        while (!m_units[m_turnOrder[position]].alive) {
+            position = m_orderNext[position];
+        }
+        setCurrent(position);
     }
+    ++m_turnCount;
+    
+    m_aiPlanned = false;
+    m_planner.cancel();
+    
+    m_entities[m_currentEntityIndex].startTurn();
 }
 
 void TurnSystem::executeEnemyAI(const Map& map) {
+    // En una repetición con IA grabada sus comandos llegan por execute()
+    if (m_enemyAI == EnemyAI::External) return;
+    
     Entity* enemy = getCurrentEntity();
-    Entity* player = getPlayer();
+    int targetIndex = enemy ? findNearestOpponent(m_currentEntityIndex) : -1;
     
-    if (!enemy || !player || !enemy->isAlive() || !player->isAlive()) {
+    if (!enemy || targetIndex < 0 || !enemy->isAlive()) {
         endCurrentTurn();
         return;
     }
+    Entity* player = &m_entities[targetIndex];
     
     // Verificar si ya está en animación de combate
     if (enemy->isPlayingCombatAnimation()) {
         // Esperar a que termine la animación de combate
-        std::cout << "Enemy esperando a que termine la animación de combate..." << std::endl;
+        LOG_TRACE(Turn, "Enemy esperando a que termine la animación de combate...");
+        return;
+    }
+    
+    if (m_enemyAI == EnemyAI::Search || m_enemyAI == EnemyAI::MonteCarlo) {
+        executePlannedAI(map);
         return;
     }
     
@@ -112,21 +400,27 @@ void TurnSystem::executeEnemyAI(const Map& map) {
     if (enemy->getRemainingPA() >= 3 && enemy->canCastSpell(player->getPosition(), 1, 3, map)) {
         // Intentar atacar
         if (enemy->tryCastStrike(player->getPosition(), *player)) {
-            std::cout << "Enemy ataca al Player!" << std::endl;
+            LOG_DEBUG(Turn, "Enemy ataca a la unidad " << targetIndex << "!");
+            refreshUnit(targetIndex);
             // NO terminar el turno inmediatamente, esperar a que termine la animación
             return;
         }
     }
     
-    // Si no puede atacar, moverse hacia el player
-    std::cout << "Enemy PA: " << enemy->getRemainingPA() << ", PM: " << enemy->getRemainingPM() << std::endl;
+    // Si no puede atacar, moverse hacia el objetivo
+    LOG_DEBUG(Turn, "Enemy PA: " << enemy->getRemainingPA() << ", PM: " << enemy->getRemainingPM());
     if (enemy->getRemainingPM() > 0) {
-        // Excluir la posición del player de las celdas alcanzables
-        std::vector<sf::Vector2i> excludedPositions = {player->getPosition()};
+        // Excluir las casillas de las demás unidades vivas
+        std::vector<sf::Vector2i> excludedPositions;
+        for (size_t i = 0; i < m_entities.size(); ++i) {
+            if (static_cast<int>(i) != m_currentEntityIndex && m_entities[i].isAlive()) {
+                excludedPositions.push_back(m_entities[i].getPosition());
+            }
+        }
         std::vector<sf::Vector2i> reachableTiles = Pathfinding::getReachableTiles(map, enemy->getPosition(), enemy->getRemainingPM(), excludedPositions);
-        std::cout << "Enemy celdas alcanzables (excluyendo player): " << reachableTiles.size() << std::endl;
+        LOG_DEBUG(Turn, "Enemy celdas alcanzables (excluyendo unidades): " << reachableTiles.size());
         
-        // Encontrar la casilla más cercana al player
+        // Encontrar la casilla más cercana al objetivo
         sf::Vector2i bestTile = enemy->getPosition();
         int bestDistance = std::abs(player->getPosition().x - enemy->getPosition().x) + 
                           std::abs(player->getPosition().y - enemy->getPosition().y);
@@ -148,7 +442,78 @@ void TurnSystem::executeEnemyAI(const Map& map) {
         }
     } else {
         // Sin PM, terminar turno
-        std::cout << "Enemy sin PM, terminando turno..." << std::endl;
+        LOG_DEBUG(Turn, "Enemy sin PM, terminando turno...");
         endCurrentTurn();
     }
 }
+
+void TurnSystem::executePlannedAI(const Map& map) {
+    // Un comando del plan por llamada: esta se repite cuando la unidad termina
+    // de moverse o de animar el hechizo anterior
+    if (!m_aiPlanned) {
+        if (m_currentEntityIndex >= TacticalState::MAX_UNITS) {
+            // Fuera de la foto de la IA: pasa turno
+            m_aiPlan = {BattleCommand::endTurn()};
+        } else if (m_asyncAI) {
+            // El mapa cambió mientras pensaba: la foto ya no vale
+            if (m_planner.isThinking() && map.getRevision() != m_aiMapRevision) {
+                m_planner.cancel();
+            }
+            if (!m_planner.isThinking()) {
+                startPlanning(map);
+                return;
+            }
+            // Mientras tanto la unidad sigue animándose en update()
+            if (!m_planner.poll(m_aiPlan)) return;
+            LOG_DEBUG(Turn, "IA: plan listo en " << m_planner.getLastThinkMilliseconds() << " ms"
+                      << (m_planner.wasLastCancelled() ? " (cancelada por plazo)" : ""));
+        } else {
+            const TacticalState root = snapshotState();
+            m_aiPlan = m_enemyAI == EnemyAI::MonteCarlo ? m_monteCarloAI.decide(root, map)
+                                                        : m_tacticalAI.decide(root, map);
+        }
+        m_aiPlanStep = 0;
+        m_aiPlanned = true;
+    }
+    
+    if (m_aiPlanStep >= m_aiPlan.size()) {
+        applyCommand(BattleCommand::endTurn(), map);
+        return;
+    }
+    const BattleCommand command = m_aiPlan[m_aiPlanStep++];
+    if (!applyCommand(command, map)) {
+        LOG_DEBUG(Turn, "IA: comando del plan rechazado (tipo " << static_cast<int>(command.type) << ")");
+    }
+}
+
+void TurnSystem::startPlanning(const Map& map) {
+    // Foto inmutable en el hilo principal; el hilo de la IA solo ve la copia
+    TacticalState root = snapshotState();
+    m_aiMapRevision = map.getRevision();
+    
+    AsyncPlanner::DecideFunction decide;
+    if (m_enemyAI == EnemyAI::MonteCarlo) {
+        decide = [this](const TacticalState& state, const Map& snapshot, const std::atomic<bool>& cancel) {
+            return m_monteCarloAI.decide(state, snapshot, &cancel);
+        };
+    } else {
+        decide = [this](const TacticalState& state, const Map& snapshot, const std::atomic<bool>& cancel) {
+            return m_tacticalAI.decide(state, snapshot, &cancel);
+        };
+    }
+    m_planner.start(std::move(decide), root, m_planner.snapshot(map), std::chrono::milliseconds(m_aiDeadlineMs));
+}
+
+void TurnSystem::setEnemyAI(EnemyAI ai) {
+    if (ai != m_enemyAI) {
+        m_planner.cancel();
+        m_aiPlanned = false;
+    }
+    m_enemyAI = ai;
+}
+
+void TurnSystem::setAsyncAI(bool async, int deadlineMs) {
+    if (!async) m_planner.cancel();
+    m_asyncAI = async;
+    m_aiDeadlineMs = deadlineMs;
+}
@@ -1,35 +1,151 @@
 #pragma once
 #include "units/Entity.h"
 #include "map/Map.h"
+#include "systems/Replay.h"
+#include "systems/AsyncPlanner.h"
+#include "systems/MonteCarloAI.h"
+#include "systems/TacticalAI.h"
+#include <cstdint>
 #include <vector>
 
+// Quién ordena la unidad actual: Player = comandos por execute(), Enemy = la IA
 enum class TurnState {
     Player,
     Enemy
 };
 
+// Quién decide los turnos de los enemigos
+enum class EnemyAI {
+    Greedy,      // Regla fija: atacar si puede, si no acercarse (se re-simula en repeticiones)
+    Search,      // TacticalAI; sus comandos se graban porque dependen del tiempo de búsqueda
+    MonteCarlo,  // MonteCarloAI (varias unidades); se graba igual que Search
+    External     // Nadie: los comandos llegan por execute() (repeticiones con IA grabada)
+};
+
 class TurnSystem {
 public:
+    // Paso fijo de simulación: toda la lógica avanza en ticks para que una
+    // repetición reproduzca exactamente la misma partida
+    static constexpr float TICK_SECONDS = 1.0f / 60.0f;
+    // Plazo por defecto de una decisión asíncrona de la IA antes de cancelarla
+    static constexpr int AI_DEADLINE_MS = 1000;
+    
     TurnSystem();
     
-    void addEntity(Entity* entity);
+    // Guarda una copia de la vista (el estado sigue en su EntityStore).
+    // team < 0 = por tipo (Player 0, Enemy 1). Juega antes la iniciativa más
+    // alta; a igualdad, el orden de alta
+    void addEntity(const Entity& entity, int team = -1, int initiative = 0);
     void startGame();
     void endCurrentTurn();
     void update(float deltaTime, const Map& map);
     
+    // Ejecuta un comando del jugador (y lo registra si hay log de repetición)
+    bool execute(const BattleCommand& command, Map& map);
+    void setRecorder(ReplayRecorder* recorder) { m_recorder = recorder; }
+    // Graba un checkpoint con el tick y el estado actuales y cierra el log
+    void finishRecording(const Map& map);
+    
+    void setEnemyAI(EnemyAI ai);
+    EnemyAI getEnemyAI() const { return m_enemyAI; }
+    // Cancelan la decisión asíncrona en curso: el hilo del planificador no
+    // sigue usando la IA mientras se reconfigura
+    TacticalAI& getTacticalAI() { m_planner.cancel(); return m_tacticalAI; }
+    MonteCarloAI& getMonteCarloAI() { m_planner.cancel(); return m_monteCarloAI; }
+    
+    // Search y MonteCarlo piensan en otro hilo sobre una foto de la batalla y
+    // update() solo consulta el resultado. Solo para partidas interactivas:
+    // cuántos ticks tarda la decisión depende del reloj.
+    void setAsyncAI(bool async, int deadlineMs = AI_DEADLINE_MS);
+    bool isAIThinking() const { return m_planner.isThinking(); }
+    const AsyncPlanner& getPlanner() const { return m_planner; }
+    
+    uint32_t getTick() const { return m_tick; }
+    int getTurnCount() const { return m_turnCount; }
+    uint64_t computeStateHash(const Map& map) const;
+    
     TurnState getCurrentTurn() const;
-    Entity* getCurrentEntity() const;
-    Entity* getPlayer() const;
-    Entity* getEnemy() const;
+    Entity* getCurrentEntity();
+    const Entity* getCurrentEntity() const;
+    int getCurrentTeam() const;
+    // Primera unidad de cada tipo dada de alta
+    Entity* getPlayer();
+    const Entity* getPlayer() const;
+    Entity* getEnemy();
+    const Entity* getEnemy() const;
+    
+    size_t getEntityCount() const { return m_entities.size(); }
+    int getTeam(size_t index) const { return m_units[index].team; }
+    int getInitiative(size_t index) const { return m_units[index].initiative; }
+    // Índices de las entidades en orden de turno (incluye las muertas)
+    const std::vector<int>& getTurnOrder() const { return m_turnOrder; }
+    const std::vector<Entity>& getEntities() const { return m_entities; }
+    
+    // La batalla termina cuando solo queda un equipo con unidades vivas
+    bool isBattleOver() const { return m_teamsAlive < 2; }
+    // Equipo superviviente; -1 si la batalla sigue (o no queda nadie)
+    int getWinningTeam() const;
+    int getAliveCount(int team) const;
     
     bool isPlayerTurn() const;
     bool isEnemyTurn() const;
     
 private:
-    std::vector<Entity*> m_entities;
+    struct UnitInfo {
+        int team;
+        int initiative;
+        int orderPosition;   // Posición en m_turnOrder
+        bool alive;          // Último estado visto (refreshUnit)
+    };
+    
+    std::vector<Entity> m_entities;
+    std::vector<UnitInfo> m_units;
     TurnState m_currentTurn;
     int m_currentEntityIndex;
     
+    // Orden de turnos fijado en startGame(). Las unidades vivas forman una
+    // lista circular doblemente enlazada sobre las posiciones de m_turnOrder:
+    // una muerte la desengancha en O(1) y pasar turno no recorre las muertas.
+    std::vector<int> m_turnOrder;
+    std::vector<int> m_orderNext;
+    std::vector<int> m_orderPrev;
+    int m_orderPosition = 0;
+    std::vector<int> m_teamAlive;       // Unidades vivas por equipo
+    int m_teamsAlive = 0;
+    int m_playerIndex = -1;
+    int m_enemyIndex = -1;
+    
+    // Estado de repetición
+    uint32_t m_tick;
+    int m_turnCount;
+    int m_checkpointTurn;
+    ReplayRecorder* m_recorder;
+    bool m_endCheckpointed = false;     // Ya hay checkpoint del final de la batalla
+    
+    // IA de los enemigos: con Search o MonteCarlo el plan del turno se calcula una vez y
+    // se ejecuta un comando cada vez que la unidad queda libre
+    EnemyAI m_enemyAI = EnemyAI::Greedy;
+    TacticalAI m_tacticalAI;
+    MonteCarloAI m_monteCarloAI;
+    std::vector<BattleCommand> m_aiPlan;
+    size_t m_aiPlanStep = 0;
+    bool m_aiPlanned = false;
+    bool m_asyncAI = false;
+    int m_aiDeadlineMs = AI_DEADLINE_MS;
+    uint32_t m_aiMapRevision = 0;       // Revisión del mapa de la foto en curso
+    AsyncPlanner m_planner;             // Después de las IA: se destruye antes que ellas
+    
     void nextTurn();
+    void buildTurnOrder();
+    void setCurrent(int orderPosition);
+    // Actualiza equipos vivos y orden de turnos si la unidad murió o revivió
+    void refreshUnit(int index);
+    // Unidad viva de otro equipo más cercana a index; -1 si no hay
+    int findNearestOpponent(int index) const;
+    TacticalState snapshotState() const;
     void executeEnemyAI(const Map& map);
+    void executePlannedAI(const Map& map);
+    void startPlanning(const Map& map);
+    // Move, CastSpell y EndTurn de la unidad actual (registrados en la repetición)
+    bool applyCommand(const BattleCommand& command, const Map& map);
 };
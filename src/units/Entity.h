@@ -1,53 +1,56 @@
 #pragma once
-#include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
+#include <algorithm>
 #include <vector>
 #include "map/Map.h"
 #include "systems/Pathfinding.h"
 #include "systems/Spells.h"
-#include "systems/Assets.h"
-#include "systems/Animation.h"
-
-enum class EntityType {
-    Player,
-    Enemy
-};
-
-enum class EntityState {
-    Idle,
-    Moving
-};
+#include "units/EntityStore.h"
 
+// Vista de una unidad de un EntityStore (posición, recursos, movimiento y
+// temporizador de combate). No guarda estado propio: es un puntero al almacén
+// y un id, así que copiarla es barato y todas las copias ven la misma unidad.
+// El sprite y la animación viven en EntityView.
 class Entity {
 public:
-    Entity(sf::Vector2i startPosition, EntityType type);
+    Entity(EntityStore& store, EntityId id);
+    
+    EntityId getId() const { return m_id; }
+    EntityStore& getStore() const { return *m_store; }
     
     void update(float deltaTime);
-    void render(sf::RenderWindow& window, const Map& map);
     
     void moveTo(sf::Vector2i targetPosition, const Map& map);
     void setPosition(sf::Vector2i position);
     
-    sf::Vector2i getPosition() const { return m_currentPosition; }
-    bool isMoving() const { return m_state == EntityState::Moving; }
-    int getRemainingPM() const { return m_remainingPM; }
-    int getTotalPM() const { return m_totalPM; }
-    int getRemainingPA() const { return m_remainingPA; }
-    int getTotalPA() const { return m_totalPA; }
-    int getHP() const { return m_hp; }
-    EntityType getType() const { return m_type; }
-    EntityState getState() const { return m_state; }
-    sf::FloatRect getGlobalBounds() const;
+    sf::Vector2i getPosition() const { return m_store->position(m_id); }
+    bool isMoving() const { return m_store->motion(m_id).state == EntityState::Moving; }
+    int getRemainingPM() const { return m_store->resources(m_id).remainingPM; }
+    int getTotalPM() const { return m_store->resources(m_id).totalPM; }
+    int getRemainingPA() const { return m_store->resources(m_id).remainingPA; }
+    int getTotalPA() const { return m_store->resources(m_id).totalPA; }
+    int getHP() const { return m_store->resources(m_id).hp; }
+    EntityType getType() const { return m_store->getType(m_id); }
+    EntityState getState() const { return m_store->motion(m_id).state; }
+    
+    // Consultas para la capa de vista
+    int getDirection() const { return m_store->motion(m_id).direction; } // 0=idle, 1=up, 2=left, 3=down, 4=right
+    sf::Vector2i getNextStep() const;
+    // Progreso del paso actual [0,1]; extraSeconds permite interpolar entre ticks
+    float getStepProgress(float extraSeconds = 0.f) const {
+        return std::min(1.f, (m_store->path(m_id).timer + extraSeconds) / EntityStore::MOVEMENT_SPEED);
+    }
+    int getCombatAnimation() const { return m_store->combat(m_id).type; }
     
     std::vector<sf::Vector2i> getReachableTiles(const Map& map) const;
     void startTurn();
     void endTurn();
-    int stepsRemainingInQueue() const { return static_cast<int>(m_movementPath.size()); }
+    int stepsRemainingInQueue() const { return m_store->path(m_id).remaining(); }
     
     // Sistema de combate
     bool tryCastStrike(sf::Vector2i targetCell, Entity& target);
     void takeDamage(int damage);
-    bool isAlive() const { return m_hp > 0; }
+    bool isAlive() const { return getHP() > 0; }
     bool isInRange(sf::Vector2i target, int maxRange) const;
     
     // Sistema de hechizos mejorado
@@ -64,51 +67,12 @@ public:
     
     // Sistema de animaciones de combate
     void startCombatAnimation(int animationType); // 0=arco, 1=ataquearco, 2=heal
-    bool isPlayingCombatAnimation() const { return m_currentCombatAnimation >= 0; }
+    bool isPlayingCombatAnimation() const { return getCombatAnimation() >= 0; }
     void stopCombatAnimation();
     
 private:
-    // Constantes para centrado y escalado
-    static constexpr float kTileHeightMultiplier = 2.6f;
-    static constexpr float FOOT_PADDING = 12.0f;
-    
-    sf::Vector2i m_currentPosition;
-    sf::Vector2f m_screenPosition;
-    std::vector<sf::Vector2i> m_movementPath;
-    float m_movementTimer;
-    static constexpr float MOVEMENT_SPEED = 0.18f; // segundos por casilla
-    
-    sf::CircleShape m_entityShape;
-    sf::Vector2f m_targetScreenPosition;
-    bool m_isMovingToTarget;
-    
-    // Sistema de sprites con múltiples direcciones
-    bool m_useSprite = false;
-    sf::Sprite m_sprite; // Inicializar sin textura
-    sf::Texture* m_texture = nullptr; // Textura principal (spritesheet)
-    sf::Texture* m_textures[5]; // 0=idle, 1=right, 2=left, 3=forward, 4=back
-    Animation m_anim;
-    sf::Vector2f m_spriteOffset = {0.f, 0.f}; // para ajustar apoyo en losetas
-    sf::Vector2f m_spriteScale = {1.f, 1.f};
-    int m_currentDirection = 0; // 0=idle, 1=up, 2=left, 3=down, 4=right
-    
-    // Sistema de animaciones de combate
-    sf::Texture* m_combatTextures[3]; // 0=arco, 1=ataquearco, 2=heal
-    int m_currentCombatAnimation = -1; // -1=none, 0=arco, 1=ataquearco, 2=heal
-    float m_combatAnimationTimer = 0.f;
-    static constexpr float COMBAT_ANIMATION_DURATION = 1.5f; // Duración de animación de combate
-    
-    // Sistema de recursos
-    int m_totalPM;
-    int m_remainingPM;
-    int m_totalPA;
-    int m_remainingPA;
-    int m_hp;
-    EntityType m_type;
-    EntityState m_state;
+    EntityStore* m_store;
+    EntityId m_id;
     
-    void updateMovement(float deltaTime);
-    void updateScreenPosition(const Map& map);
-    void consumePM(int amount);
     void setDirection(int direction);
 };
@@ -0,0 +1,62 @@
+#include "units/EntityStore.h"
+#include "systems/Log.h"
+#include <algorithm>
+
+EntityId EntityStore::create(sf::Vector2i position, EntityType type) {
+    EntityId id = static_cast<EntityId>(m_types.size());
+    m_types.push_back(type);
+    m_positions.push_back(position);
+    m_resources.push_back({100, 6, 6, 3, 3});
+    m_paths.emplace_back();
+    m_motions.emplace_back();
+    m_combat.emplace_back();
+    return id;
+}
+
+void EntityStore::updateMovement(EntityId id, float deltaTime) {
+    Path& path = m_paths[id];
+    Motion& motion = m_motions[id];
+    if (path.empty()) {
+        motion.state = EntityState::Idle;
+        motion.direction = 0; // Volver a idle
+        return;
+    }
+    
+    // Determinar dirección de movimiento para animación
+    sf::Vector2i& position = m_positions[id];
+    sf::Vector2i direction = path.cells[path.next] - position;
+    
+    // Convertir dirección a índice (1=up, 2=left, 3=down, 4=right)
+    if (direction.y < 0) motion.direction = 1;      // Up
+    else if (direction.x < 0) motion.direction = 2; // Left
+    else if (direction.y > 0) motion.direction = 3; // Down
+    else if (direction.x > 0) motion.direction = 4; // Right
+    else motion.direction = 0;
+    
+    path.timer += deltaTime;
+    if (path.timer < MOVEMENT_SPEED) return;
+    path.timer = 0.0f;
+    
+    position = path.cells[path.next++];
+    Resources& resources = m_resources[id];
+    resources.remainingPM = std::max(0, resources.remainingPM - 1); // Descontar 1 PM por cada paso
+    LOG_TRACE(Entity, "Paso completado. PM restantes: " << resources.remainingPM);
+    
+    if (path.empty()) {
+        path.cells.clear();
+        path.next = 0;
+        motion.state = EntityState::Idle;
+        motion.direction = 0; // Volver a idle
+    }
+}
+
+void EntityStore::updateCombatAnimation(EntityId id, float deltaTime) {
+    CombatAnimation& combat = m_combat[id];
+    if (combat.type < 0) return;
+    combat.timer += deltaTime;
+    if (combat.timer >= COMBAT_ANIMATION_DURATION) {
+        LOG_DEBUG(Entity, "Stopped combat animation: " << combat.type);
+        combat.type = -1;
+        combat.timer = 0.f;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <vector>
+
+enum class EntityType {
+    Player,
+    Enemy
+};
+
+enum class EntityState {
+    Idle,
+    Moving
+};
+
+// Identificador estable de una unidad: índice en los arrays de EntityStore.
+// Las unidades no se borran (las muertas conservan su hueco), así que un id
+// vale para toda la batalla.
+using EntityId = uint32_t;
+
+// Componentes de simulación de todas las unidades, cada uno en su propio array
+// contiguo (estructura de arrays) indexado por EntityId. Cada sistema recorre
+// solo lo que usa: el hash de estado lee posiciones, recursos y caminos; el
+// movimiento, el camino y la posición de la unidad que juega; la foto de la IA,
+// posiciones y recursos. El estado de render vive aparte, en EntityView.
+class EntityStore {
+public:
+    static constexpr float MOVEMENT_SPEED = 0.18f;            // segundos por casilla
+    static constexpr float COMBAT_ANIMATION_DURATION = 1.5f;  // La IA espera a que termine
+    
+    struct Resources {
+        int hp;
+        int totalPA;
+        int remainingPA;
+        int totalPM;
+        int remainingPM;
+    };
+    
+    // Casillas pendientes desde next (avanzar no desplaza el vector)
+    struct Path {
+        std::vector<sf::Vector2i> cells;
+        uint32_t next = 0;
+        float timer = 0.f;
+        
+        bool empty() const { return next >= cells.size(); }
+        int remaining() const { return static_cast<int>(cells.size() - next); }
+    };
+    
+    struct Motion {
+        EntityState state = EntityState::Idle;
+        int direction = 0;   // 0=idle, 1=up, 2=left, 3=down, 4=right
+    };
+    
+    struct CombatAnimation {
+        int type = -1;       // -1=none, 0=ataqueespadaa, 1=ataquearco, 2=heal
+        float timer = 0.f;
+    };
+    
+    EntityId create(sf::Vector2i position, EntityType type);
+    size_t size() const { return m_types.size(); }
+    
+    EntityType getType(EntityId id) const { return m_types[id]; }
+    sf::Vector2i& position(EntityId id) { return m_positions[id]; }
+    sf::Vector2i position(EntityId id) const { return m_positions[id]; }
+    Resources& resources(EntityId id) { return m_resources[id]; }
+    const Resources& resources(EntityId id) const { return m_resources[id]; }
+    Path& path(EntityId id) { return m_paths[id]; }
+    const Path& path(EntityId id) const { return m_paths[id]; }
+    Motion& motion(EntityId id) { return m_motions[id]; }
+    const Motion& motion(EntityId id) const { return m_motions[id]; }
+    CombatAnimation& combat(EntityId id) { return m_combat[id]; }
+    const CombatAnimation& combat(EntityId id) const { return m_combat[id]; }
+    
+    // Arrays completos, para recorrer un componente de todas las unidades
+    const std::vector<sf::Vector2i>& getPositions() const { return m_positions; }
+    const std::vector<Resources>& getResources() const { return m_resources; }
+    const std::vector<Path>& getPaths() const { return m_paths; }
+    
+    // Sistemas: cada uno toca solo sus componentes
+    void updateMovement(EntityId id, float deltaTime);      // Camino, movimiento, posición y PM
+    void updateCombatAnimation(EntityId id, float deltaTime);
+
+private:
+    std::vector<EntityType> m_types;
+    std::vector<sf::Vector2i> m_positions;
+    std::vector<Resources> m_resources;
+    std::vector<Path> m_paths;
+    std::vector<Motion> m_motions;
+    std::vector<CombatAnimation> m_combat;
+};
@@ -53,7 +53,7 @@ Pawn::Pawn(sf::Vector2i startPosition)
         }
         
         m_sprite.setOrigin({ frameSize.x * 0.5f, static_cast<float>(frameSize.y) - FOOT_PADDING });
-        const float targetHeight = Map::TILE_SIZE * kTileHeightMultiplier;
+        const float targetHeight = MapView::TILE_SIZE * kTileHeightMultiplier;
         float scale = (targetHeight / static_cast<float>(frameSize.y)) * 0.9f;
         if (!std::isfinite(scale) || scale <= 0.f) scale = 1.f;
         m_sprite.setScale({scale, scale});
@@ -79,7 +79,7 @@ void Pawn::update(float deltaTime) {
     }
 }
 
-void Pawn::render(sf::RenderWindow& window, const Map& map) {
+void Pawn::render(sf::RenderWindow& window, const MapView& map) {
     updateScreenPosition(map);
     
     if (m_useSprite) {
@@ -180,7 +180,7 @@ void Pawn::updateMovement(float deltaTime) {
     }
 }
 
-void Pawn::updateScreenPosition(const Map& map) {
+void Pawn::updateScreenPosition(const MapView& map) {
     sf::Vector2f targetPos = map.getTileCenter(m_currentPosition.x, m_currentPosition.y);
     
     if (m_isMovingToTarget && !m_movementPath.empty()) {
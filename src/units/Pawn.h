@@ -3,6 +3,7 @@
 #include <SFML/System.hpp>
 #include <vector>
 #include "map/Map.h"
+#include "view/MapView.h"
 #include "systems/Pathfinding.h"
 #include "systems/Assets.h"
 #include "systems/Animation.h"
@@ -17,7 +18,7 @@ public:
     Pawn(sf::Vector2i startPosition);
     
     void update(float deltaTime);
-    void render(sf::RenderWindow& window, const Map& map);
+    void render(sf::RenderWindow& window, const MapView& map);
     
     void moveTo(sf::Vector2i targetPosition, const Map& map);
     void setPosition(sf::Vector2i position);
@@ -62,6 +63,6 @@ private:
     PawnState m_state;
     
     void updateMovement(float deltaTime);
-    void updateScreenPosition(const Map& map);
+    void updateScreenPosition(const MapView& map);
     void consumePM(int amount);
 };
@@ -0,0 +1,36 @@
+#include "view/Camera.h"
+#include <algorithm>
+#include "systems/Display.h"
+
+Camera::Camera() {
+    reset();
+}
+
+void Camera::reset() {
+    m_center = sf::Vector2f(Display::VIRTUAL_W * 0.5f, Display::VIRTUAL_H * 0.5f);
+    m_zoom = 1.0f;
+}
+
+void Camera::pan(sf::Vector2f worldDelta) {
+    m_center += worldDelta;
+}
+
+void Camera::zoomAt(float factor, sf::Vector2f worldPoint) {
+    float newZoom = std::clamp(m_zoom * factor, MIN_ZOOM, MAX_ZOOM);
+    if (newZoom == m_zoom) return;
+    
+    m_center = worldPoint + (m_center - worldPoint) * (newZoom / m_zoom);
+    m_zoom = newZoom;
+}
+
+sf::View Camera::getView(sf::Vector2u windowSize) const {
+    sf::View view = Display::makeLetterboxedView(windowSize);
+    view.setCenter(m_center);
+    view.setSize(sf::Vector2f(Display::VIRTUAL_W, Display::VIRTUAL_H) * m_zoom);
+    return view;
+}
+
+sf::FloatRect Camera::getWorldRect() const {
+    sf::Vector2f size = sf::Vector2f(Display::VIRTUAL_W, Display::VIRTUAL_H) * m_zoom;
+    return sf::FloatRect(m_center - size * 0.5f, size);
+}
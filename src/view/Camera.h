@@ -0,0 +1,29 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Cámara del mundo: desplazamiento y zoom sobre la vista virtual letterbox de
+// Display. El HUD se sigue dibujando con la vista fija.
+class Camera {
+public:
+    static constexpr float MIN_ZOOM = 0.25f;  // Acercar (4x)
+    static constexpr float MAX_ZOOM = 8.0f;   // Alejar (ver mapas grandes)
+    
+    Camera();
+    
+    void reset();
+    void pan(sf::Vector2f worldDelta);
+    // Zoom manteniendo fijo el punto del mundo bajo el cursor
+    void zoomAt(float factor, sf::Vector2f worldPoint);
+    
+    // Vista letterbox para la ventana con el centro y zoom de la cámara
+    sf::View getView(sf::Vector2u windowSize) const;
+    // Rectángulo visible en coordenadas de mundo
+    sf::FloatRect getWorldRect() const;
+    
+    float getZoom() const { return m_zoom; }
+    sf::Vector2f getCenter() const { return m_center; }
+    
+private:
+    sf::Vector2f m_center;
+    float m_zoom;
+};
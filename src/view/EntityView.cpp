@@ -0,0 +1,272 @@
+#include "view/EntityView.h"
+#include <algorithm>
+#include <cmath>
+#include "systems/Log.h"
+
+const std::vector<std::string>& EntityView::getPreloadGroups() {
+    static const std::vector<std::string> groups = {"units", "combat"};
+    return groups;
+}
+
+unsigned int EntityView::getAtlasFrameHeight(float displayScale) {
+    const float pixels = MapView::TILE_SIZE * kTileHeightMultiplier * 0.9f * displayScale * ATLAS_ZOOM_HEADROOM;
+    const unsigned int steps = static_cast<unsigned int>(std::ceil(pixels / ATLAS_FRAME_STEP));
+    return std::max(1u, steps) * ATLAS_FRAME_STEP;
+}
+
+EntityView::EntityView(const Entity& entity, const SpriteAtlas& atlas)
+    : m_entity(entity),
+      m_atlas(atlas),
+      m_screenPosition(0, 0),
+      m_currentDirection(0) {
+    
+    // Configurar círculo de fallback
+    m_entityShape.setRadius(8.0f);
+    m_entityShape.setFillColor(m_entity.getType() == EntityType::Player ? sf::Color::Blue : sf::Color::Red);
+    m_entityShape.setOutlineColor(sf::Color::White);
+    m_entityShape.setOutlineThickness(2.0f);
+    m_entityShape.setOrigin({8.0f, 8.0f});
+    
+    // Hasta que el atlas termine de cargar se dibuja el círculo
+    std::fill(std::begin(m_sheets), std::end(m_sheets), -1);
+    std::fill(std::begin(m_combatSheets), std::end(m_combatSheets), -1);
+    if (m_atlas.isReady()) {
+        resolveSheets();
+    }
+}
+
+void EntityView::resolveSheets() {
+    m_atlasGeneration = m_atlas.getGeneration();
+    m_activeSheet = -1;
+    m_useSheetRows = false;
+    std::fill(std::begin(m_sheets), std::end(m_sheets), -1);
+    
+    // El mismo spritesheet para player y enemy para consistencia de tamaño
+    LOG_DEBUG(View, "Sprites for " << (m_entity.getType() == EntityType::Player ? "player" : "enemy") << "...");
+    // Hoja única "player" (una fila por dirección) si el manifiesto la declara
+    int mainSheet = m_atlas.findSheet("player");
+    
+    if (mainSheet >= 0) {
+        // Usar el mismo sprite para todas las direcciones (el spritesheet tiene todas las animaciones)
+        for (int i = 0; i < 5; i++) {
+            m_sheets[i] = mainSheet;
+        }
+        m_useSheetRows = true;
+    } else {
+        // Fallback a sprites individuales (enemigos usan los mismos que el player)
+        m_sheets[0] = m_atlas.findSheet("player_idle");      // Idle
+        m_sheets[1] = m_atlas.findSheet("player_right");     // Derecha
+        m_sheets[2] = m_atlas.findSheet("player_left");      // Izquierda
+        m_sheets[3] = m_atlas.findSheet("player_forward");   // Adelante
+        m_sheets[4] = m_atlas.findSheet("player_back");      // Atrás
+    }
+    
+    // Animaciones de combate (para ambos player y enemy)
+    m_combatSheets[0] = m_atlas.findSheet("attack_sword"); // Ataque con espada
+    m_combatSheets[1] = m_atlas.findSheet("attack_bow");   // Ataque con arco
+    m_combatSheets[2] = m_atlas.findSheet("heal");         // Curación
+    
+    // Hoja inicial: idle o la primera disponible
+    for (int i = 0; i < 5 && m_activeSheet < 0; i++) {
+        m_activeSheet = m_sheets[i];
+    }
+    
+    if (m_activeSheet >= 0) {
+        const SpriteAtlas::Sheet& sheet = m_atlas.getSheet(m_activeSheet);
+        m_anim.columns = sheet.columns;
+        m_anim.frameSize = sheet.sourceFrameSize;
+        m_anim.row = 0;
+        m_anim.current = 0;
+        m_anim.timer = 0.f;
+        m_anim.frameDuration = 0.12f;
+        
+        // Escala según la altura del frame original (no la del atlas)
+        const float targetHeight = MapView::TILE_SIZE * kTileHeightMultiplier;
+        m_scale = (targetHeight / static_cast<float>(sheet.sourceFrameSize.y)) * 0.9f;
+        if (!std::isfinite(m_scale) || m_scale <= 0.f) m_scale = 1.f;
+        
+        // No usar offset adicional para centrar correctamente en la loseta
+        m_spriteOffset = {-14.f, 0.f};
+        m_useSprite = true;
+        
+        LOG_DEBUG(View, "sprite ON frame=" << sheet.sourceFrameSize.x << "x" << sheet.sourceFrameSize.y
+            << " grid=" << sheet.columns << "x" << sheet.rows << " scale=" << m_scale);
+    } else {
+        m_useSprite = false;
+        LOG_DEBUG(View, "sprite OFF (fallback)");
+    }
+}
+
+void EntityView::update(float deltaTime) {
+    // Cambiar el placeholder por el sprite en cuanto el atlas esté listo, y
+    // volver a buscar las hojas si el atlas se reconstruyó (recarga en caliente)
+    if (m_atlas.isReady() && m_atlasGeneration != m_atlas.getGeneration()) {
+        resolveSheets();
+        if (m_currentCombatAnimation >= 0) {
+            startCombatAnimation(m_currentCombatAnimation);
+        }
+        setDirection(m_currentDirection);
+    }
+    
+    // Sincronizar con el estado de la entidad
+    if (m_entity.getCombatAnimation() != m_currentCombatAnimation) {
+        if (m_entity.getCombatAnimation() >= 0) {
+            startCombatAnimation(m_entity.getCombatAnimation());
+        } else {
+            stopCombatAnimation();
+        }
+    }
+    if (m_entity.getDirection() != m_currentDirection) {
+        setDirection(m_entity.getDirection());
+    }
+    
+    if (m_currentCombatAnimation >= 0) {
+        // Actualizar animación de combate
+        m_anim.update(deltaTime);
+    } else if (m_useSprite) {
+        // Animación normal de movimiento
+        if (m_entity.isMoving()) {
+            m_anim.update(deltaTime);
+        } else {
+            m_anim.reset();
+        }
+    }
+}
+
+void EntityView::render(SpriteBatch& batch, sf::RenderTarget& target, const MapView& map, float interpolationSeconds) {
+    updateScreenPosition(map, interpolationSeconds);
+    
+    if (m_useSprite && m_activeSheet >= 0) {
+        // Frame actual (la animación avanza en update cuando corresponde)
+        const SpriteAtlas::Sheet& sheet = m_atlas.getSheet(m_activeSheet);
+        const SpriteAtlas::Frame& frame = m_atlas.getFrame(m_activeSheet, m_anim.current, m_anim.row);
+        
+        // Origin en los pies (bottom-center), en píxeles del frame original
+        const sf::Vector2f frameSize(sheet.sourceFrameSize);
+        const sf::Vector2f origin(frameSize.x * 0.5f, frameSize.y - FOOT_PADDING);
+        const sf::Vector2f drawPos = m_screenPosition + m_spriteOffset;
+        const sf::Vector2f topLeft = sf::Vector2f(std::round(drawPos.x), std::round(drawPos.y)) - origin * m_scale;
+        const sf::Vector2f size = frameSize * m_scale;
+        
+        const sf::Vector2f corners[4] = {
+            topLeft, topLeft + sf::Vector2f(size.x, 0.f), topLeft + size, topLeft + sf::Vector2f(0.f, size.y)
+        };
+        batch.add(frame, corners);
+        m_bounds = sf::FloatRect(topLeft, size);
+    } else {
+        // Fallback al círculo
+        m_entityShape.setPosition(m_screenPosition);
+        target.draw(m_entityShape);
+        m_bounds = m_entityShape.getGlobalBounds();
+    }
+}
+
+void EntityView::updateScreenPosition(const MapView& map, float interpolationSeconds) {
+    sf::Vector2i position = m_entity.getPosition();
+    sf::Vector2f currentScreenPos = map.getTileCenter(position.x, position.y);
+    
+    if (m_entity.isMoving() && m_entity.stepsRemainingInQueue() > 0) {
+        // Interpolar entre la casilla actual y la siguiente del camino. La posición
+        // depende solo del estado de simulación (no del frame anterior), así que
+        // es independiente de la tasa de render.
+        sf::Vector2i nextPos = m_entity.getNextStep();
+        sf::Vector2f nextScreenPos = map.getTileCenter(nextPos.x, nextPos.y);
+        
+        float progress = m_entity.getStepProgress(interpolationSeconds);
+        m_screenPosition = currentScreenPos + (nextScreenPos - currentScreenPos) * progress;
+    } else {
+        m_screenPosition = currentScreenPos;
+    }
+}
+
+sf::FloatRect EntityView::getGlobalBounds() const {
+    return m_bounds;
+}
+
+void EntityView::setActiveSheet(int sheet) {
+    if (sheet < 0) return;
+    m_activeSheet = sheet;
+    m_anim.columns = m_atlas.getSheet(sheet).columns;
+    m_anim.frameSize = m_atlas.getSheet(sheet).sourceFrameSize;
+}
+
+void EntityView::setDirection(int direction) {
+    if (direction < 0 || direction > 4) return;
+    
+    m_currentDirection = direction;
+    
+    // No cambiar de hoja si estamos en animación de combate
+    if (m_currentCombatAnimation >= 0) {
+        return;
+    }
+    
+    if (m_useSprite) {
+        // Si tenemos el spritesheet principal, usar animación por filas
+        if (m_useSheetRows) {
+            // Mapear dirección a fila del spritesheet 3x3
+            // 0=idle, 1=up, 2=left, 3=down, 4=right
+            int row = 0; // idle por defecto
+            if (direction == 1) row = 0;      // Up (fila 0)
+            else if (direction == 2) row = 1; // Left (fila 1) 
+            else if (direction == 3) row = 0; // Down (fila 0)
+            else if (direction == 4) row = 2; // Right (fila 2)
+            
+            m_anim.setDirection(row);
+        } else if (m_sheets[direction] >= 0) {
+            // Fallback: hojas separadas por dirección
+            setActiveSheet(m_sheets[direction]);
+            m_anim.setDirection(0); // Resetear animación
+        }
+    }
+}
+
+void EntityView::startCombatAnimation(int animationType) {
+    m_currentCombatAnimation = animationType;
+    if (m_combatSheets[animationType] < 0) {
+        LOG_DEBUG(View, "Combat animation " << animationType << " sin hoja");
+        return;
+    }
+    
+    // Configurar la animación con la rejilla de la hoja de combate
+    setActiveSheet(m_combatSheets[animationType]);
+    m_anim.row = 0; // Empezar en la primera fila
+    m_anim.current = 0;
+    m_anim.timer = 0.f;
+    m_anim.frameDuration = 0.15f; // 150ms por frame (más rápido)
+    
+    // Asegurar que el sprite esté visible
+    m_useSprite = true;
+}
+
+void EntityView::stopCombatAnimation() {
+    m_currentCombatAnimation = -1;
+    if (!m_useSprite) {
+        return;
+    }
+    
+    // Volver a la hoja de movimiento normal
+    // Asegurar que tenemos una dirección válida
+    if (m_currentDirection < 0 || m_currentDirection > 4) {
+        m_currentDirection = 0; // Idle por defecto
+    }
+    
+    if (m_sheets[m_currentDirection] >= 0) {
+        setActiveSheet(m_sheets[m_currentDirection]);
+    } else {
+        LOG_ERROR(View, "No movement sheet found for direction: " << m_currentDirection);
+        // Fallback a la primera hoja disponible
+        for (int i = 0; i < 5; i++) {
+            if (m_sheets[i] >= 0) {
+                setActiveSheet(m_sheets[i]);
+                m_currentDirection = i;
+                break;
+            }
+        }
+    }
+    
+    // Resetear animación a movimiento normal
+    m_anim.row = 0;
+    m_anim.current = 0;
+    m_anim.timer = 0.f;
+    m_anim.frameDuration = 0.2f;
+}
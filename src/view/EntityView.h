@@ -0,0 +1,66 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+#include "units/Entity.h"
+#include "view/MapView.h"
+#include <string>
+#include <vector>
+#include "view/SpriteAtlas.h"
+#include "systems/Animation.h"
+
+// Capa de render de una Entity: sprites por dirección, animaciones de combate
+// e interpolación en pantalla. Solo lee el estado de la entidad. Los frames
+// salen del atlas compartido y se añaden a un SpriteBatch, así que cambiar de
+// dirección o de animación solo cambia el rectángulo, nunca la textura.
+class EntityView {
+public:
+    EntityView(const Entity& entity, const SpriteAtlas& atlas);
+    
+    // Grupos del manifiesto con las hojas que usa cualquier EntityView
+    static const std::vector<std::string>& getPreloadGroups();
+    // Alto de frame suficiente para dibujar a displayScale con algo de zoom de
+    // cámara; redondeado para que la caché en disco no cambie con cada ventana
+    static unsigned int getAtlasFrameHeight(float displayScale);
+    
+    void update(float deltaTime);
+    // interpolationSeconds: tiempo transcurrido desde el último tick de simulación.
+    // El sprite va al batch; sin sprites se dibuja el círculo directamente.
+    void render(SpriteBatch& batch, sf::RenderTarget& target, const MapView& map, float interpolationSeconds = 0.f);
+    
+    sf::FloatRect getGlobalBounds() const;
+    
+private:
+    // Constantes para centrado y escalado
+    static constexpr float kTileHeightMultiplier = 2.6f;
+    static constexpr float FOOT_PADDING = 12.0f;
+    static constexpr float ATLAS_ZOOM_HEADROOM = 1.5f;
+    static constexpr unsigned int ATLAS_FRAME_STEP = 32;
+    
+    const Entity& m_entity;
+    const SpriteAtlas& m_atlas;
+    sf::Vector2f m_screenPosition;
+    sf::CircleShape m_entityShape;
+    
+    // Sistema de sprites con múltiples direcciones (índices de hoja del atlas, -1 = sin hoja)
+    bool m_useSprite = false;
+    bool m_useSheetRows = false; // Spritesheet único con una fila por dirección
+    uint32_t m_atlasGeneration = 0; // Distribución del atlas resuelta (0 = ninguna todavía)
+    int m_sheets[5]; // 0=idle, 1=right, 2=left, 3=forward, 4=back
+    int m_activeSheet = -1;
+    Animation m_anim;
+    float m_scale = 1.f;
+    sf::Vector2f m_spriteOffset = {0.f, 0.f}; // para ajustar apoyo en losetas
+    sf::FloatRect m_bounds;
+    int m_currentDirection = 0; // Dirección mostrada (sigue a Entity::getDirection)
+    
+    // Sistema de animaciones de combate
+    int m_combatSheets[3]; // 0=attack_sword, 1=attack_bow, 2=heal
+    int m_currentCombatAnimation = -1; // Animación mostrada (sigue a Entity::getCombatAnimation)
+    
+    void resolveSheets();
+    void setActiveSheet(int sheet);
+    void updateScreenPosition(const MapView& map, float interpolationSeconds);
+    void setDirection(int direction);
+    void startCombatAnimation(int animationType);
+    void stopCombatAnimation();
+};
@@ -0,0 +1,72 @@
+#include "view/MapOverlays.h"
+
+MapOverlays::MapOverlays(const Map& map) : m_map(map) {
+    for (auto& layer : m_layers) {
+        fitToMap(layer);
+    }
+}
+
+bool MapOverlays::fitToMap(Layer& layer) {
+    // Mismo número de casillas no basta: 15x20 y 20x15 indexan distinto
+    if (layer.width == m_map.getWidth() && layer.height == m_map.getHeight()) return false;
+    layer.width = m_map.getWidth();
+    layer.height = m_map.getHeight();
+    layer.mask.assign(static_cast<size_t>(layer.width) * layer.height, 0);
+    layer.tiles.clear();
+    layer.vertices.clear();
+    return true;
+}
+
+void MapOverlays::setTiles(OverlayLayer layerId, const std::vector<sf::Vector2i>& tiles, sf::Color color) {
+    Layer& layer = get(layerId);
+    // Si el mapa cambió de forma la máscara anterior ya no es válida
+    if (!fitToMap(layer) && layer.tiles == tiles && layer.color == color) {
+        return; // Sin cambios: nada que regenerar
+    }
+    
+    for (const auto& tile : layer.tiles) {
+        layer.mask[tile.y * m_map.getWidth() + tile.x] = 0;
+    }
+    layer.tiles.clear();
+    layer.color = color;
+    layer.vertices.clear();
+    
+    for (const auto& tile : tiles) {
+        if (!m_map.isValidPosition(tile.x, tile.y)) continue;
+        layer.tiles.push_back(tile);
+        layer.mask[tile.y * m_map.getWidth() + tile.x] = 1;
+        
+        sf::Vertex diamond[MapView::FILL_VERTICES_PER_TILE];
+        MapView::writeDiamond(diamond, tile, color);
+        for (const auto& vertex : diamond) {
+            layer.vertices.append(vertex);
+        }
+    }
+}
+
+void MapOverlays::clear(OverlayLayer layerId) {
+    Layer& layer = get(layerId);
+    if (fitToMap(layer) || layer.tiles.empty()) return;
+    
+    for (const auto& tile : layer.tiles) {
+        layer.mask[tile.y * m_map.getWidth() + tile.x] = 0;
+    }
+    layer.tiles.clear();
+    layer.vertices.clear();
+}
+
+bool MapOverlays::contains(OverlayLayer layerId, sf::Vector2i tile) const {
+    if (!m_map.isValidPosition(tile.x, tile.y)) return false;
+    const Layer& layer = get(layerId);
+    if (layer.width != m_map.getWidth() || layer.height != m_map.getHeight()) return false;
+    return layer.mask[static_cast<size_t>(tile.y) * layer.width + tile.x] != 0;
+}
+
+void MapOverlays::draw(sf::RenderTarget& target, const MapView& mapView) const {
+    sf::RenderStates states(mapView.getTransform());
+    for (const auto& layer : m_layers) {
+        if (layer.visible && layer.vertices.getVertexCount() > 0) {
+            target.draw(layer.vertices, states);
+        }
+    }
+}
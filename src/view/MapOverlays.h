@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "map/Map.h"
+#include "view/MapView.h"
+
+// Capas de resaltado sobre el tablero, en orden de dibujo
+enum class OverlayLayer {
+    Reachable,      // Casillas alcanzables con los PM restantes
+    PathPreview,    // Camino hasta la casilla bajo el cursor
+    Castable,       // Celdas válidas del hechizo activo
+    AreaOfEffect,   // Zona de impacto del hechizo en la celda apuntada
+    Count
+};
+
+// Cada capa guarda su conjunto de losetas en un VertexArray que solo se
+// regenera cuando el conjunto cambia; se dibuja con una llamada por capa
+// visible y no vacía. Incluye una máscara para consultas de pertenencia O(1).
+class MapOverlays {
+public:
+    explicit MapOverlays(const Map& map);
+    
+    void setTiles(OverlayLayer layer, const std::vector<sf::Vector2i>& tiles, sf::Color color);
+    void clear(OverlayLayer layer);
+    void setVisible(OverlayLayer layer, bool visible) { get(layer).visible = visible; }
+    
+    bool contains(OverlayLayer layer, sf::Vector2i tile) const;
+    const std::vector<sf::Vector2i>& getTiles(OverlayLayer layer) const { return get(layer).tiles; }
+    
+    void draw(sf::RenderTarget& target, const MapView& mapView) const;
+    
+private:
+    struct Layer {
+        std::vector<sf::Vector2i> tiles;
+        std::vector<uint8_t> mask;
+        int width = 0;      // Mapa para el que se construyó la máscara
+        int height = 0;
+        sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+        sf::Color color;
+        bool visible = true;
+    };
+    
+    const Map& m_map;
+    std::array<Layer, static_cast<size_t>(OverlayLayer::Count)> m_layers;
+    
+    // Si el mapa cambió de forma vacía la capa y rehace la máscara; true si la vació
+    bool fitToMap(Layer& layer);
+    
+    Layer& get(OverlayLayer layer) { return m_layers[static_cast<size_t>(layer)]; }
+    const Layer& get(OverlayLayer layer) const { return m_layers[static_cast<size_t>(layer)]; }
+};
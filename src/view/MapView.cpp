@@ -0,0 +1,337 @@
+#include "view/MapView.h"
+#include <algorithm>
+#include <cmath>
+#include "systems/ThreadPool.h"
+#include "systems/Log.h"
+#include "systems/Profiler.h"
+
+MapView::MapView(const Map& map)
+    : m_map(map),
+      m_hoveredTile(-1, -1),
+      m_useVertexBuffer(sf::VertexBuffer::isAvailable()),
+      m_buildResults(std::make_shared<BuildResults>()) {
+    // Offset inicial; se recalcula al aplicar letterboxing para centrar
+    m_offset = sf::Vector2f(0.0f, 0.0f);
+    rebuildLayout();
+}
+
+void MapView::render(sf::RenderWindow& window) {
+    PROFILE_ZONE("MapView::render");
+    syncWithMap();
+    collectBuilds();
+    requestBuilds();
+    
+    // Los vértices están en coordenadas del mapa: el offset va en la transformación
+    sf::RenderStates states(getTransform());
+    
+    for (size_t index : m_visibleChunks) {
+        const Chunk& chunk = *m_chunks[index];
+        if (!chunk.hasMesh) continue;
+        if (m_useVertexBuffer) {
+            window.draw(chunk.fillBuffer, states);
+        } else {
+            window.draw(chunk.fillVertices.data(), chunk.fillVertices.size(), sf::PrimitiveType::Triangles, states);
+        }
+    }
+    
+    // Resaltar la loseta bajo el cursor con un único quad encima del relleno
+    if (m_map.isValidPosition(m_hoveredTile.x, m_hoveredTile.y)) {
+        sf::Vertex hover[FILL_VERTICES_PER_TILE];
+        writeDiamond(hover, m_hoveredTile, sf::Color::Yellow);
+        window.draw(hover, FILL_VERTICES_PER_TILE, sf::PrimitiveType::Triangles, states);
+    }
+    
+    for (size_t index : m_visibleChunks) {
+        const Chunk& chunk = *m_chunks[index];
+        if (!chunk.hasMesh) continue;
+        if (m_useVertexBuffer) {
+            window.draw(chunk.outlineBuffer, states);
+        } else {
+            window.draw(chunk.outlineVertices.data(), chunk.outlineVertices.size(), sf::PrimitiveType::Lines, states);
+        }
+    }
+}
+
+void MapView::setVisibleRect(const sf::FloatRect& worldRect) {
+    // Una loseta con esquina (sx, sy) = ((x-y)*T/2, (x+y)*T/2) ocupa [sx, sx+T] x [sy, sy+T]
+    const sf::Vector2f local = worldRect.position - m_offset;
+    const float half = TILE_SIZE * 0.5f;
+    const int minU = static_cast<int>(std::floor(local.x / half)) - 2;
+    const int maxU = static_cast<int>(std::ceil((local.x + worldRect.size.x) / half));
+    const int minV = static_cast<int>(std::floor(local.y / half)) - 2;
+    const int maxV = static_cast<int>(std::ceil((local.y + worldRect.size.y) / half));
+    
+    // La cámara quieta no obliga a recalcular la lista de chunks
+    if (m_hasVisibleRect && minU == m_minU && maxU == m_maxU && minV == m_minV && maxV == m_maxV) return;
+    
+    m_minU = minU;
+    m_maxU = maxU;
+    m_minV = minV;
+    m_maxV = maxV;
+    m_hasVisibleRect = true;
+    rebuildVisibleChunks();
+}
+
+bool MapView::isTileVisible(sf::Vector2i tile, int margin) const {
+    if (!m_map.isValidPosition(tile.x, tile.y)) return false;
+    if (!m_hasVisibleRect) return true;
+    
+    int u = tile.x - tile.y;
+    int v = tile.x + tile.y;
+    return u >= m_minU - margin && u <= m_maxU + margin && v >= m_minV - margin && v <= m_maxV + margin;
+}
+
+bool MapView::isChunkVisible(const Chunk& chunk) const {
+    if (!m_hasVisibleRect) return true;
+    
+    // El chunk cubre u en [x0 - y1, x1 - y0] y v en [x0 + y0, x1 + y1]
+    const int x0 = chunk.origin.x, x1 = chunk.origin.x + chunk.size.x - 1;
+    const int y0 = chunk.origin.y, y1 = chunk.origin.y + chunk.size.y - 1;
+    return x1 - y0 >= m_minU && x0 - y1 <= m_maxU && x1 + y1 >= m_minV && x0 + y0 <= m_maxV;
+}
+
+void MapView::rebuildLayout() {
+    const int width = m_map.getWidth();
+    const int height = m_map.getHeight();
+    m_layoutSize = sf::Vector2i(width, height);
+    m_chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    
+    m_chunks.clear();
+    m_chunks.reserve(static_cast<size_t>(m_chunksX) * m_chunksY);
+    for (int cy = 0; cy < m_chunksY; ++cy) {
+        for (int cx = 0; cx < m_chunksX; ++cx) {
+            auto chunk = std::make_unique<Chunk>();
+            chunk->origin = sf::Vector2i(cx * CHUNK_SIZE, cy * CHUNK_SIZE);
+            chunk->size = sf::Vector2i(std::min(CHUNK_SIZE, width - chunk->origin.x),
+                                       std::min(CHUNK_SIZE, height - chunk->origin.y));
+            m_chunks.push_back(std::move(chunk));
+        }
+    }
+    
+    // Los resultados en vuelo del layout anterior se descartan al recogerlos
+    m_layoutId++;
+    m_builtRevision = m_map.getRevision();
+    rebuildVisibleChunks();
+}
+
+void MapView::rebuildVisibleChunks() {
+    m_visibleChunks.clear();
+    
+    if (!m_hasVisibleRect) {
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            m_visibleChunks.push_back(i);
+        }
+        return;
+    }
+    
+    // Solo se recorren las filas de chunks que pueden cortar el rectángulo:
+    // una fila de losetas y es visible para x en [minU + y, maxU + y] ∩ [minV - y, maxV - y]
+    const int width = m_map.getWidth();
+    for (int cy = 0; cy < m_chunksY; ++cy) {
+        const int y0 = cy * CHUNK_SIZE;
+        const int y1 = std::min(m_map.getHeight(), y0 + CHUNK_SIZE) - 1;
+        const int x0 = std::max({0, m_minU + y0, m_minV - y1});
+        const int x1 = std::min({width - 1, m_maxU + y1, m_maxV - y0});
+        if (x0 > x1) continue;
+        
+        for (int cx = x0 / CHUNK_SIZE; cx <= x1 / CHUNK_SIZE; ++cx) {
+            const size_t index = static_cast<size_t>(cy) * m_chunksX + cx;
+            if (isChunkVisible(*m_chunks[index])) {
+                m_visibleChunks.push_back(index);
+            }
+        }
+    }
+}
+
+void MapView::syncWithMap() {
+    if (m_map.getRevision() == m_builtRevision) return;
+    
+    // Cambio de tamaño o demasiados cambios para el registro: recrear todo
+    const bool sizeChanged = m_layoutSize != sf::Vector2i(m_map.getWidth(), m_map.getHeight());
+    if (sizeChanged || !m_map.getChangesSince(m_builtRevision, m_changedTiles)) {
+        if (sizeChanged) {
+            rebuildLayout();
+        } else {
+            for (auto& chunk : m_chunks) chunk->dirty = true;
+            m_builtRevision = m_map.getRevision();
+        }
+        return;
+    }
+    
+    for (const sf::Vector2i& tile : m_changedTiles) {
+        const size_t index = static_cast<size_t>(tile.y / CHUNK_SIZE) * m_chunksX + tile.x / CHUNK_SIZE;
+        m_chunks[index]->dirty = true;
+    }
+    m_builtRevision = m_map.getRevision();
+}
+
+void MapView::requestBuilds() {
+    // Solo se construyen los chunks sucios que están en pantalla; el resto
+    // espera a que la cámara los alcance
+    for (size_t index : m_visibleChunks) {
+        Chunk& chunk = *m_chunks[index];
+        if (!chunk.dirty || chunk.inFlight) continue;
+        
+        // Copia del estado de las losetas: Map no se toca fuera del hilo principal
+        std::vector<uint8_t> blocked(static_cast<size_t>(chunk.size.x) * chunk.size.y);
+        for (int y = 0; y < chunk.size.y; ++y) {
+            for (int x = 0; x < chunk.size.x; ++x) {
+                blocked[y * chunk.size.x + x] = m_map.isBlocked(chunk.origin.x + x, chunk.origin.y + y) ? 1 : 0;
+            }
+        }
+        chunk.dirty = false;
+        
+        if (!m_workerPool) {
+            ChunkMesh mesh = buildChunkMesh(chunk.origin, chunk.size, blocked);
+            mesh.chunkIndex = index;
+            mesh.layoutId = m_layoutId;
+            applyMesh(mesh);
+            continue;
+        }
+        
+        chunk.inFlight = true;
+        m_pendingBuilds++;
+        m_workerPool->submit([results = m_buildResults, index, layoutId = m_layoutId,
+                              origin = chunk.origin, size = chunk.size, blocked = std::move(blocked)]() {
+            ChunkMesh mesh = buildChunkMesh(origin, size, blocked);
+            mesh.chunkIndex = index;
+            mesh.layoutId = layoutId;
+            std::lock_guard<std::mutex> lock(results->mutex);
+            results->meshes.push_back(std::move(mesh));
+        });
+    }
+}
+
+void MapView::collectBuilds() {
+    if (m_pendingBuilds == 0) return;
+    
+    std::vector<ChunkMesh> meshes;
+    {
+        std::lock_guard<std::mutex> lock(m_buildResults->mutex);
+        meshes.swap(m_buildResults->meshes);
+    }
+    
+    for (ChunkMesh& mesh : meshes) {
+        m_pendingBuilds--;
+        if (mesh.layoutId != m_layoutId) continue;
+        m_chunks[mesh.chunkIndex]->inFlight = false;
+        applyMesh(mesh);
+    }
+}
+
+void MapView::applyMesh(ChunkMesh& mesh) {
+    Chunk& chunk = *m_chunks[mesh.chunkIndex];
+    chunk.fillVertices = std::move(mesh.fillVertices);
+    chunk.outlineVertices = std::move(mesh.outlineVertices);
+    chunk.hasMesh = true;
+    
+    if (!m_useVertexBuffer) return;
+    
+    if (chunk.fillBuffer.getVertexCount() != chunk.fillVertices.size()) {
+        m_useVertexBuffer = chunk.fillBuffer.create(chunk.fillVertices.size()) &&
+                            chunk.outlineBuffer.create(chunk.outlineVertices.size());
+    }
+    m_useVertexBuffer = m_useVertexBuffer &&
+                        chunk.fillBuffer.update(chunk.fillVertices.data()) &&
+                        chunk.outlineBuffer.update(chunk.outlineVertices.data());
+    
+    if (m_useVertexBuffer) {
+        // En GPU: la copia en CPU ya no hace falta
+        chunk.fillVertices = std::vector<sf::Vertex>();
+        chunk.outlineVertices = std::vector<sf::Vertex>();
+    } else {
+        // Sin buffer en GPU se dibuja desde la copia en CPU: los chunks ya
+        // subidos la descartaron, hay que reconstruirlos
+        LOG_WARN(View, "VertexBuffer falló, usando arrays de vértices");
+        for (auto& other : m_chunks) {
+            if (other.get() != &chunk && other->hasMesh) {
+                other->hasMesh = false;
+                other->dirty = true;
+            }
+        }
+    }
+}
+
+MapView::ChunkMesh MapView::buildChunkMesh(sf::Vector2i origin, sf::Vector2i size, const std::vector<uint8_t>& blocked) {
+    ChunkMesh mesh;
+    const size_t tileCount = static_cast<size_t>(size.x) * size.y;
+    mesh.fillVertices.resize(tileCount * FILL_VERTICES_PER_TILE);
+    mesh.outlineVertices.resize(tileCount * OUTLINE_VERTICES_PER_TILE);
+    
+    for (int y = 0; y < size.y; ++y) {
+        for (int x = 0; x < size.x; ++x) {
+            const size_t tileIndex = static_cast<size_t>(y) * size.x + x;
+            const sf::Color color = blocked[tileIndex] ? sf::Color::Red : sf::Color::Green;
+            sf::Vertex* fill = &mesh.fillVertices[tileIndex * FILL_VERTICES_PER_TILE];
+            writeDiamond(fill, origin + sf::Vector2i(x, y), color);
+            
+            // Contorno: top-right, right-bottom, bottom-left, left-top
+            sf::Vertex* outline = &mesh.outlineVertices[tileIndex * OUTLINE_VERTICES_PER_TILE];
+            const sf::Vector2f corners[4] = {fill[0].position, fill[1].position, fill[2].position, fill[5].position};
+            for (int i = 0; i < 4; ++i) {
+                outline[i * 2] = {corners[i], sf::Color::Black};
+                outline[i * 2 + 1] = {corners[(i + 1) % 4], sf::Color::Black};
+            }
+        }
+    }
+    return mesh;
+}
+
+sf::Transform MapView::getTransform() const {
+    sf::Transform transform;
+    transform.translate(m_offset);
+    return transform;
+}
+
+void MapView::writeDiamond(sf::Vertex* out, sf::Vector2i tile, sf::Color color) {
+    const sf::Vector2f origin = Isometric::isoToScreen(tile, sf::Vector2f(TILE_SIZE, TILE_SIZE));
+    const sf::Vector2f top = origin + sf::Vector2f(TILE_SIZE * 0.5f, 0.f);
+    const sf::Vector2f right = origin + sf::Vector2f(TILE_SIZE, TILE_SIZE * 0.5f);
+    const sf::Vector2f bottom = origin + sf::Vector2f(TILE_SIZE * 0.5f, TILE_SIZE);
+    const sf::Vector2f left = origin + sf::Vector2f(0.f, TILE_SIZE * 0.5f);
+    out[0] = {top, color};
+    out[1] = {right, color};
+    out[2] = {bottom, color};
+    out[3] = {top, color};
+    out[4] = {bottom, color};
+    out[5] = {left, color};
+}
+
+bool MapView::updateHover(sf::Vector2f mousePos) {
+    sf::Vector2i tile = getTileFromPosition(mousePos);
+    if (tile == m_hoveredTile) return false;
+    m_hoveredTile = tile;
+    return true;
+}
+
+sf::Vector2f MapView::getTileCenter(int x, int y) const {
+    sf::Vector2f screenPos = Isometric::isoToScreen(sf::Vector2i(x, y), sf::Vector2f(TILE_SIZE, TILE_SIZE));
+    screenPos += m_offset;
+    screenPos.x += TILE_SIZE * 0.5f;
+    screenPos.y += TILE_SIZE * 0.5f;
+    return screenPos;
+}
+
+sf::Vector2f MapView::getTileTopLeft(int x, int y) const {
+    sf::Vector2f screenPos = Isometric::isoToScreen(sf::Vector2i(x, y), sf::Vector2f(TILE_SIZE, TILE_SIZE));
+    screenPos += m_offset;
+    return screenPos;
+}
+
+void MapView::setCenteredOffset(sf::Vector2f viewSize) {
+    // Centrar el rombo del mapa dentro de la vista virtual 1280x720. En
+    // coordenadas locales el rombo va de x = -(alto-1)*T/2 a (ancho-1)*T/2 + T
+    // y de y = 0 a (ancho+alto-2)*T/2 + T.
+    const float width = static_cast<float>(m_map.getWidth());
+    const float height = static_cast<float>(m_map.getHeight());
+    const float centerX = (width - height) * TILE_SIZE * 0.25f + TILE_SIZE * 0.5f;
+    const float centerY = (width + height) * TILE_SIZE * 0.25f;
+    m_offset.x = viewSize.x * 0.5f - centerX;
+    m_offset.y = viewSize.y * 0.5f - centerY;
+}
+
+sf::Vector2i MapView::getTileFromPosition(sf::Vector2f position) const {
+    sf::Vector2f relativePos = position - m_offset;
+    return Isometric::screenToIso(relativePos, sf::Vector2f(TILE_SIZE, TILE_SIZE));
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "map/Map.h"
+#include "map/Isometric.h"
+
+class ThreadPool;
+
+// Capa de render del tablero: proyección isométrica, hover y dibujo de losetas.
+// El terreno se divide en chunks de CHUNK_SIZE x CHUNK_SIZE losetas, cada uno
+// con sus propios buffers de vértices (rellenos + contornos) en coordenadas
+// locales del mapa. Un cambio en Map solo marca sucio el chunk que contiene la
+// loseta; los chunks sucios se reconstruyen cuando entran en pantalla, en los
+// hilos del pool si hay uno, y el hilo principal solo sube el resultado a la
+// GPU. Solo se dibujan los chunks que cortan el rectángulo visible de la cámara.
+class MapView {
+public:
+    static constexpr float TILE_SIZE = 40.0f;
+    static constexpr int CHUNK_SIZE = 16;
+    
+    explicit MapView(const Map& map);
+    
+    // Pool para construir chunks en segundo plano (nullptr = en el hilo principal)
+    void setWorkerPool(ThreadPool* pool) { m_workerPool = pool; }
+    
+    void render(sf::RenderWindow& window);
+    // Devuelve true si la loseta resaltada cambió (hay que redibujar)
+    bool updateHover(sf::Vector2f mousePos);
+    // Hay chunks construyéndose: el siguiente frame los mostrará
+    bool hasPendingBuilds() const { return m_pendingBuilds > 0; }
+    
+    sf::Vector2f getTileCenter(int x, int y) const;
+    sf::Vector2f getTileTopLeft(int x, int y) const;
+    void setCenteredOffset(sf::Vector2f viewSize);
+    sf::Vector2i getTileFromPosition(sf::Vector2f position) const;
+    
+    // Culling: rectángulo visible en coordenadas de mundo (vista de la cámara)
+    void setVisibleRect(const sf::FloatRect& worldRect);
+    // margin en losetas, para sprites que sobresalen de su casilla
+    bool isTileVisible(sf::Vector2i tile, int margin = 0) const;
+    int getVisibleChunkCount() const { return static_cast<int>(m_visibleChunks.size()); }
+    
+    const Map& getMap() const { return m_map; }
+    sf::Vector2i getHoveredTile() const { return m_hoveredTile; }
+    
+    // Transformación de coordenadas locales del mapa a coordenadas de la vista
+    sf::Transform getTransform() const;
+    
+    // Rombo de una loseta como 2 triángulos en coordenadas locales del mapa
+    static constexpr int FILL_VERTICES_PER_TILE = 6;
+    static void writeDiamond(sf::Vertex* out, sf::Vector2i tile, sf::Color color);
+    
+private:
+    static constexpr int OUTLINE_VERTICES_PER_TILE = 8;  // 4 segmentos
+    
+    struct Chunk {
+        sf::Vector2i origin;   // Primera loseta del chunk
+        sf::Vector2i size;     // Los chunks del borde pueden ser más pequeños
+        sf::VertexBuffer fillBuffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static};
+        sf::VertexBuffer outlineBuffer{sf::PrimitiveType::Lines, sf::VertexBuffer::Usage::Static};
+        // Copia en CPU; solo se conserva si no hay VertexBuffer
+        std::vector<sf::Vertex> fillVertices;
+        std::vector<sf::Vertex> outlineVertices;
+        bool hasMesh = false;
+        bool dirty = true;
+        bool inFlight = false;
+    };
+    
+    // Resultado de construir un chunk. Se genera fuera del hilo principal a
+    // partir de una copia del estado de sus losetas, nunca leyendo Map.
+    struct ChunkMesh {
+        size_t chunkIndex;
+        uint32_t layoutId;
+        std::vector<sf::Vertex> fillVertices;
+        std::vector<sf::Vertex> outlineVertices;
+    };
+    
+    // Buzón compartido con las tareas del pool: sobrevive a MapView si aún
+    // quedan tareas en vuelo
+    struct BuildResults {
+        std::mutex mutex;
+        std::vector<ChunkMesh> meshes;
+    };
+    
+    const Map& m_map;
+    sf::Vector2i m_hoveredTile;
+    sf::Vector2f m_offset;
+    
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    sf::Vector2i m_layoutSize;
+    int m_chunksX = 0;
+    int m_chunksY = 0;
+    uint32_t m_layoutId = 0;        // Cambia al recrear los chunks (tamaño del mapa)
+    uint32_t m_builtRevision = 0;
+    std::vector<sf::Vector2i> m_changedTiles;
+    bool m_useVertexBuffer;
+    
+    ThreadPool* m_workerPool = nullptr;
+    std::shared_ptr<BuildResults> m_buildResults;
+    int m_pendingBuilds = 0;
+    
+    // Rango visible en ejes u = x - y, v = x + y (diagonales de pantalla)
+    bool m_hasVisibleRect = false;
+    int m_minU = 0, m_maxU = 0, m_minV = 0, m_maxV = 0;
+    std::vector<size_t> m_visibleChunks;
+    
+    void rebuildLayout();
+    void rebuildVisibleChunks();
+    bool isChunkVisible(const Chunk& chunk) const;
+    void syncWithMap();
+    void requestBuilds();
+    void collectBuilds();
+    void applyMesh(ChunkMesh& mesh);
+    static ChunkMesh buildChunkMesh(sf::Vector2i origin, sf::Vector2i size, const std::vector<uint8_t>& blocked);
+};
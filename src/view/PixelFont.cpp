@@ -0,0 +1,77 @@
+#include "view/PixelFont.h"
+#include <cctype>
+#include <cstdint>
+
+namespace {
+    // Cada glifo: 5 filas de 3 bits (bit 2 = columna izquierda)
+    struct Glyph {
+        char c;
+        uint8_t rows[5];
+    };
+    
+    const Glyph GLYPHS[] = {
+        {'0', {7, 5, 5, 5, 7}}, {'1', {2, 6, 2, 2, 7}}, {'2', {7, 1, 7, 4, 7}},
+        {'3', {7, 1, 7, 1, 7}}, {'4', {5, 5, 7, 1, 1}}, {'5', {7, 4, 7, 1, 7}},
+        {'6', {7, 4, 7, 5, 7}}, {'7', {7, 1, 1, 2, 2}}, {'8', {7, 5, 7, 5, 7}},
+        {'9', {7, 5, 7, 1, 7}}, {'.', {0, 0, 0, 0, 2}}, {':', {0, 2, 0, 2, 0}},
+        {'%', {5, 1, 2, 4, 5}}, {'/', {1, 1, 2, 4, 4}}, {'-', {0, 0, 7, 0, 0}},
+        {'=', {0, 7, 0, 7, 0}}, {'(', {1, 2, 2, 2, 1}}, {')', {4, 2, 2, 2, 4}},
+        {'A', {2, 5, 7, 5, 5}}, {'B', {6, 5, 6, 5, 6}}, {'C', {7, 4, 4, 4, 7}},
+        {'D', {6, 5, 5, 5, 6}}, {'E', {7, 4, 6, 4, 7}}, {'F', {7, 4, 6, 4, 4}},
+        {'G', {7, 4, 5, 5, 7}}, {'H', {5, 5, 7, 5, 5}}, {'I', {7, 2, 2, 2, 7}},
+        {'J', {1, 1, 1, 5, 7}}, {'K', {5, 5, 6, 5, 5}}, {'L', {4, 4, 4, 4, 7}},
+        {'M', {5, 7, 7, 5, 5}}, {'N', {6, 5, 5, 5, 5}}, {'O', {7, 5, 5, 5, 7}},
+        {'P', {7, 5, 7, 4, 4}}, {'Q', {7, 5, 5, 7, 1}}, {'R', {6, 5, 6, 5, 5}},
+        {'S', {7, 4, 7, 1, 7}}, {'T', {7, 2, 2, 2, 2}}, {'U', {5, 5, 5, 5, 7}},
+        {'V', {5, 5, 5, 5, 2}}, {'W', {5, 5, 7, 7, 5}}, {'X', {5, 5, 2, 5, 5}},
+        {'Y', {5, 5, 2, 2, 2}}, {'Z', {7, 1, 2, 4, 7}}, {'_', {0, 0, 0, 0, 7}}
+    };
+    
+    const Glyph* findGlyph(char c) {
+        char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        for (const auto& glyph : GLYPHS) {
+            if (glyph.c == upper) return &glyph;
+        }
+        return nullptr; // Espacio o carácter no soportado
+    }
+}
+
+namespace PixelFont {
+    void appendRect(sf::VertexArray& vertices, sf::Vector2f position, sf::Vector2f size, sf::Color color) {
+        sf::Vector2f a = position;
+        sf::Vector2f b = {position.x + size.x, position.y};
+        sf::Vector2f c = position + size;
+        sf::Vector2f d = {position.x, position.y + size.y};
+        vertices.append({a, color});
+        vertices.append({b, color});
+        vertices.append({c, color});
+        vertices.append({a, color});
+        vertices.append({c, color});
+        vertices.append({d, color});
+    }
+    
+    void appendText(sf::VertexArray& vertices, const std::string& text, sf::Vector2f position, float pixel, sf::Color color) {
+        sf::Vector2f pen = position;
+        for (char c : text) {
+            if (c == '\n') {
+                pen.x = position.x;
+                pen.y += (GLYPH_H + 2) * pixel;
+                continue;
+            }
+            if (const Glyph* glyph = findGlyph(c)) {
+                for (int row = 0; row < GLYPH_H; ++row) {
+                    for (int col = 0; col < GLYPH_W; ++col) {
+                        if (glyph->rows[row] & (4 >> col)) {
+                            appendRect(vertices, {pen.x + col * pixel, pen.y + row * pixel}, {pixel, pixel}, color);
+                        }
+                    }
+                }
+            }
+            pen.x += (GLYPH_W + 1) * pixel;
+        }
+    }
+    
+    float textWidth(const std::string& text, float pixel) {
+        return static_cast<float>(text.size()) * (GLYPH_W + 1) * pixel;
+    }
+}
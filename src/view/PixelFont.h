@@ -0,0 +1,19 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Fuente bitmap mínima (3x5) para overlays de depuración: el proyecto no
+// incluye ningún .ttf, así que los números se dibujan como quads.
+namespace PixelFont {
+    inline constexpr int GLYPH_W = 3;
+    inline constexpr int GLYPH_H = 5;
+    
+    // Añade el texto como triángulos a `vertices` (PrimitiveType::Triangles).
+    // `pixel` es el tamaño de un píxel de la fuente en coordenadas de mundo.
+    void appendText(sf::VertexArray& vertices, const std::string& text, sf::Vector2f position, float pixel, sf::Color color);
+    
+    // Añade un rectángulo sólido (fondos, barras de gráficas)
+    void appendRect(sf::VertexArray& vertices, sf::Vector2f position, sf::Vector2f size, sf::Color color);
+    
+    float textWidth(const std::string& text, float pixel);
+}
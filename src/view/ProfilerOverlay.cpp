@@ -0,0 +1,143 @@
+#include "view/ProfilerOverlay.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "systems/Profiler.h"
+#include "view/PixelFont.h"
+
+ProfilerOverlay::ProfilerOverlay() : m_vertices(sf::PrimitiveType::Triangles) {
+}
+
+void ProfilerOverlay::buildRows() {
+    m_rows.clear();
+    size_t frames = std::min(BREAKDOWN_FRAMES, Profiler::getFrameCount());
+    
+    for (size_t age = 0; age < frames; ++age) {
+        const Profiler::Frame& frame = Profiler::getFrame(age);
+        // Fila abierta en cada profundidad mientras se recorren las zonas
+        int openRows[Profiler::MAX_DEPTH];
+        for (const Profiler::Zone& zone : frame.zones) {
+            int parent = zone.depth > 0 ? openRows[zone.depth - 1] : -1;
+            int row = -1;
+            for (size_t i = 0; i < m_rows.size(); ++i) {
+                if (m_rows[i].parent == parent && std::strcmp(m_rows[i].name, zone.name) == 0) {
+                    row = static_cast<int>(i);
+                    break;
+                }
+            }
+            if (row < 0) {
+                row = static_cast<int>(m_rows.size());
+                m_rows.push_back({zone.name, zone.depth, parent});
+            }
+            m_rows[row].totalUs += static_cast<double>(zone.durationUs);
+            m_rows[row].allocations += static_cast<double>(zone.allocations);
+            m_rows[row].calls++;
+            openRows[zone.depth] = row;
+        }
+    }
+    
+    // Orden de árbol: cada fila seguida de sus hijas, en orden de aparición
+    m_zoneRows.clear();
+    std::vector<int> stack;
+    for (int i = static_cast<int>(m_rows.size()) - 1; i >= 0; --i) {
+        if (m_rows[i].parent < 0) stack.push_back(i);
+    }
+    while (!stack.empty()) {
+        int row = stack.back();
+        stack.pop_back();
+        m_zoneRows.push_back(row);
+        for (int i = static_cast<int>(m_rows.size()) - 1; i > row; --i) {
+            if (m_rows[i].parent == row) stack.push_back(i);
+        }
+    }
+    
+    // Totales a media por frame
+    for (Row& row : m_rows) {
+        row.totalUs /= static_cast<double>(std::max<size_t>(frames, 1));
+        row.allocations /= static_cast<double>(std::max<size_t>(frames, 1));
+    }
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, sf::Vector2f origin) {
+    const float pixel = 2.f;
+    const float lineHeight = 7 * pixel;
+    const float width = 480.f;
+    const float graphHeight = 50.f;
+    
+    buildRows();
+    size_t frameCount = Profiler::getFrameCount();
+    size_t rowCount = std::min(m_zoneRows.size(), MAX_ROWS);
+    
+    double averageMs = 0.0;
+    double averageAllocs = 0.0;
+    double averageKb = 0.0;
+    size_t averaged = std::min(BREAKDOWN_FRAMES, frameCount);
+    for (size_t age = 0; age < averaged; ++age) {
+        const Profiler::Frame& frame = Profiler::getFrame(age);
+        averageMs += frame.durationUs / 1000.0;
+        averageAllocs += static_cast<double>(frame.allocations);
+        averageKb += frame.allocatedBytes / 1024.0;
+    }
+    if (averaged > 0) {
+        averageMs /= static_cast<double>(averaged);
+        averageAllocs /= static_cast<double>(averaged);
+        averageKb /= static_cast<double>(averaged);
+    }
+    
+    m_vertices.clear();
+    PixelFont::appendRect(m_vertices, origin, {width, lineHeight * (rowCount + 3) + graphHeight + 20.f}, sf::Color(0, 0, 0, 170));
+    
+    char buffer[128];
+    std::snprintf(buffer, sizeof(buffer), "PROFILER  FRAME %.2f MS (MEDIA %zu)", averageMs, averaged);
+    PixelFont::appendText(m_vertices, buffer, origin + sf::Vector2f(6.f, 6.f), pixel, sf::Color::White);
+    if (AllocTracker::ENABLED) {
+        std::snprintf(buffer, sizeof(buffer), "RESERVAS/FRAME %.1f (%.1f KB)", averageAllocs, averageKb);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "RESERVAS: SIN DOFUS_TRACK_ALLOCATIONS");
+    }
+    PixelFont::appendText(m_vertices, buffer, origin + sf::Vector2f(6.f, 6.f + lineHeight), pixel, sf::Color(200, 200, 200));
+    
+    // Gráfica de tiempos de frame, el más reciente a la derecha; la línea marca 16.7 ms
+    const sf::Vector2f graphPos(origin.x + 6.f, origin.y + 2 * lineHeight + 10.f);
+    const float graphWidth = width - 12.f;
+    const float maxMs = 33.3f;
+    const float barWidth = graphWidth / Profiler::FRAME_HISTORY;
+    for (size_t age = 0; age < frameCount; ++age) {
+        float ms = Profiler::getFrame(age).durationUs / 1000.f;
+        float h = std::min(ms / maxMs, 1.f) * graphHeight;
+        float x = graphPos.x + graphWidth - (age + 1) * barWidth;
+        sf::Color color = ms > 16.7f ? sf::Color(220, 80, 60) : sf::Color(80, 200, 90);
+        PixelFont::appendRect(m_vertices, {x, graphPos.y + graphHeight - h}, {barWidth, h}, color);
+    }
+    float budgetY = graphPos.y + graphHeight - (16.7f / maxMs) * graphHeight;
+    PixelFont::appendRect(m_vertices, {graphPos.x, budgetY}, {graphWidth, 1.f}, sf::Color(255, 255, 0, 160));
+    
+    // Desglose: ms medios por frame, llamadas por frame y reservas por frame
+    // (en rojo si la zona reserva), sangrado por profundidad
+    float y = graphPos.y + graphHeight + 8.f;
+    for (size_t i = 0; i < rowCount; ++i) {
+        const Row& row = m_rows[m_zoneRows[i]];
+        double calls = static_cast<double>(row.calls) / static_cast<double>(std::max<size_t>(averaged, 1));
+        if (calls >= 1.5) {
+            std::snprintf(buffer, sizeof(buffer), "%s (%.0f)", row.name, calls);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%s", row.name);
+        }
+        float x = origin.x + 6.f + row.depth * 4 * pixel * 2;
+        PixelFont::appendText(m_vertices, buffer, {x, y}, pixel, sf::Color(220, 220, 220));
+        
+        std::snprintf(buffer, sizeof(buffer), "%.2f MS", row.totalUs / 1000.0);
+        float valueX = origin.x + width - 6.f - PixelFont::textWidth(buffer, pixel);
+        PixelFont::appendText(m_vertices, buffer, {valueX, y}, pixel, sf::Color::White);
+        
+        if (AllocTracker::ENABLED) {
+            std::snprintf(buffer, sizeof(buffer), "%.1f", row.allocations);
+            float allocX = origin.x + width - 6.f - 9 * 4 * pixel - PixelFont::textWidth(buffer, pixel);
+            sf::Color color = row.allocations > 0.0 ? sf::Color(230, 110, 90) : sf::Color(150, 150, 150);
+            PixelFont::appendText(m_vertices, buffer, {allocX, y}, pixel, color);
+        }
+        y += lineHeight;
+    }
+    
+    target.draw(m_vertices);
+}
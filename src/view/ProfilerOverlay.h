@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// Overlay del profiler (F12): gráfica de tiempo de frame de los últimos
+// Profiler::FRAME_HISTORY frames y desglose jerárquico de zonas, con la media
+// por frame de los últimos BREAKDOWN_FRAMES (las zonas hermanas con el mismo
+// nombre se suman y muestran cuántas veces se llamaron). Con
+// DOFUS_TRACK_ALLOCATIONS muestra también las reservas de memoria por frame
+// y por zona.
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+    
+    void draw(sf::RenderTarget& target, sf::Vector2f origin);
+
+private:
+    static constexpr size_t BREAKDOWN_FRAMES = 30;
+    static constexpr size_t MAX_ROWS = 24;
+    
+    struct Row {
+        const char* name;
+        int depth;
+        int parent;       // Fila padre, -1 en el primer nivel
+        double totalUs = 0.0;
+        double allocations = 0.0;
+        long long calls = 0;
+    };
+    
+    void buildRows();
+    
+    std::vector<Row> m_rows;
+    std::vector<int> m_zoneRows;  // Fila de cada zona del frame que se agrega
+    sf::VertexArray m_vertices;
+};
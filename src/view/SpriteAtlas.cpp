@@ -0,0 +1,385 @@
+#include "view/SpriteAtlas.h"
+#include <algorithm>
+#include <numeric>
+#include "systems/Assets.h"
+#include "systems/ThreadPool.h"
+#include "systems/Log.h"
+
+namespace {
+    // Tamaño máximo de página; se limita a lo que admite la GPU
+    constexpr unsigned int MAX_PAGE_SIZE = 4096;
+}
+
+SpriteAtlas::SpriteAtlas(const std::vector<AssetManifest::Texture>& sheets, unsigned int maxFrameHeight, bool mipmaps, ThreadPool* pool)
+    : m_entries(sheets),
+      m_maxFrameHeight(maxFrameHeight),
+      m_pool(pool),
+      m_mipmaps(mipmaps),
+      m_pendingLayout(std::make_shared<PendingLayout>()),
+      m_pendingReloads(std::make_shared<PendingReloads>()) {
+    startBuild();
+}
+
+void SpriteAtlas::startBuild() {
+    if (m_building) {
+        // Ya hay una en curso: repetir al terminar para recoger el último cambio
+        m_rebuildQueued = true;
+        return;
+    }
+    m_building = true;
+    
+    if (!m_pool) {
+        adopt(buildLayout(m_entries, m_maxFrameHeight));
+        return;
+    }
+    
+    // Cargar, reducir y empaquetar en segundo plano; update() recoge el resultado
+    m_pool->submit([pending = m_pendingLayout, entries = m_entries, maxFrameHeight = m_maxFrameHeight]() {
+        Layout layout = buildLayout(entries, maxFrameHeight);
+        std::lock_guard<std::mutex> lock(pending->mutex);
+        pending->layout = std::move(layout);
+        pending->done = true;
+    });
+}
+
+bool SpriteAtlas::update() {
+    bool changed = false;
+    if (m_building && !m_hasStaged) {
+        std::unique_lock<std::mutex> lock(m_pendingLayout->mutex);
+        if (m_pendingLayout->done) {
+            Layout layout = std::move(m_pendingLayout->layout);
+            m_pendingLayout->done = false;
+            lock.unlock();
+            adopt(std::move(layout));
+        }
+    }
+    
+    // Instalar la distribución nueva de golpe, cuando todas sus páginas están en la GPU
+    if (m_hasStaged && std::all_of(m_stagedPages.begin(), m_stagedPages.end(),
+                                   [](const TextureHandle& page) { return page.isResolved(); })) {
+        commitStaged();
+        changed = true;
+    }
+    
+    if (m_reloadsInFlight > 0) {
+        std::vector<SheetReload> reloads;
+        {
+            std::lock_guard<std::mutex> lock(m_pendingReloads->mutex);
+            reloads.swap(m_pendingReloads->results);
+        }
+        for (auto& reload : reloads) {
+            m_reloadsInFlight--;
+            changed = applyReload(reload) || changed;
+        }
+    }
+    return changed;
+}
+
+void SpriteAtlas::adopt(Layout&& layout) {
+    // Los frames reducidos se dibujan ampliados: filtrado suave
+    TextureOptions options;
+    options.smooth = layout.scaled;
+    options.mipmaps = layout.scaled && m_mipmaps;
+    
+    std::string pageSizes;
+    m_stagedPages.clear();
+    for (auto& image : layout.pageImages) {
+        const std::string label = "atlas página " + std::to_string(m_stagedPages.size()) + " " +
+                                  std::to_string(image.getSize().x) + "x" + std::to_string(image.getSize().y);
+        pageSizes += " " + std::to_string(image.getSize().x) + "x" + std::to_string(image.getSize().y);
+        m_stagedPages.push_back(Assets::createTextureAsync(std::move(image), options, label));
+    }
+    LOG_INFO(Assets, "Atlas: " << layout.sheets.size() << " hojas, " << layout.frames.size()
+             << " frames en " << layout.pageImages.size() << " página(s)" << pageSizes);
+    layout.pageImages.clear();
+    m_staged = std::move(layout);
+    m_hasStaged = true;
+}
+
+void SpriteAtlas::commitStaged() {
+    m_sheets = std::move(m_staged.sheets);
+    m_frames = std::move(m_staged.frames);
+    m_sheetIndex = std::move(m_staged.sheetIndex);
+    m_pages = std::move(m_stagedPages);
+    m_staged = Layout();
+    m_stagedPages.clear();
+    m_hasStaged = false;
+    m_building = false;
+    m_generation++;
+    
+    if (m_rebuildQueued) {
+        m_rebuildQueued = false;
+        startBuild();
+    }
+}
+
+bool SpriteAtlas::reloadSheet(const std::string& path) {
+    auto entry = std::find_if(m_entries.begin(), m_entries.end(),
+                              [&](const AssetManifest::Texture& texture) { return texture.path == path; });
+    if (entry == m_entries.end()) return false;
+    
+    // Solo se pueden reescribir en el sitio los frames propios de una hoja ya
+    // instalada; si comparte frames con otra (deduplicada) hay que reconstruir
+    const int sheet = isReady() ? findSheet(entry->id) : -1;
+    bool shared = sheet < 0;
+    for (size_t i = 0; sheet >= 0 && i < m_sheets.size(); ++i) {
+        shared = shared || (static_cast<int>(i) != sheet && m_sheets[i].firstFrame == m_sheets[sheet].firstFrame);
+    }
+    if (shared || m_building) {
+        LOG_INFO(Assets, entry->id << " cambió: reconstruyendo el atlas");
+        startBuild();
+        return true;
+    }
+    
+    const Sheet info = m_sheets[sheet];
+    const std::vector<Frame> frames(m_frames.begin() + info.firstFrame,
+                                    m_frames.begin() + info.firstFrame + static_cast<size_t>(info.columns) * info.rows);
+    auto task = [pending = m_pendingReloads, texture = *entry, info, frames, maxFrameHeight = m_maxFrameHeight,
+                 generation = m_generation]() {
+        SheetReload reload;
+        reload.path = texture.path;
+        reload.generation = generation;
+        sf::Clock clock;
+        ScaledSheet loaded;
+        reload.ok = Assets::loadScaledSheet(texture.path, texture.columns, texture.rows, maxFrameHeight, loaded);
+        if (reload.ok) {
+            reload.needsRebuild = loaded.columns != info.columns || loaded.rows != info.rows ||
+                                  loaded.frameSize != info.frameSize || loaded.sourceFrameSize != info.sourceFrameSize;
+        }
+        
+        // Recortar cada frame aquí para que el hilo principal solo tenga que subirlo
+        for (size_t i = 0; reload.ok && !reload.needsRebuild && i < frames.size(); ++i) {
+            if (frames[i].rect.size.x == 0) continue;
+            const sf::Vector2u size(frames[i].rect.size);
+            const sf::Vector2i source(static_cast<int>((i % info.columns) * size.x), static_cast<int>((i / info.columns) * size.y));
+            FramePatch patch{frames[i].page, sf::Vector2u(frames[i].rect.position), sf::Image(size, sf::Color::Transparent)};
+            if (patch.image.copy(loaded.image, {0u, 0u}, sf::IntRect(source, sf::Vector2i(size)))) {
+                reload.patches.push_back(std::move(patch));
+            }
+        }
+        
+        reload.timing.label = texture.id + " (" + texture.path + ", recarga)";
+        reload.timing.decodeMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+        reload.timing.bytes = static_cast<size_t>(loaded.image.getSize().x) * loaded.image.getSize().y * 4;
+        reload.timing.fromCache = loaded.fromCache;
+        std::lock_guard<std::mutex> lock(pending->mutex);
+        pending->results.push_back(std::move(reload));
+    };
+    
+    m_reloadsInFlight++;
+    if (m_pool) {
+        m_pool->submit(std::move(task));
+    } else {
+        task();
+    }
+    return true;
+}
+
+bool SpriteAtlas::applyReload(SheetReload& reload) {
+    if (!reload.ok) {
+        LOG_INFO(Assets, "No se pudo recargar " << reload.path << "; se mantiene la versión anterior");
+        return false;
+    }
+    if (reload.needsRebuild) {
+        LOG_INFO(Assets, reload.path << " cambió de tamaño: reconstruyendo el atlas");
+        startBuild();
+        return false;
+    }
+    if (reload.generation != m_generation) {
+        // Se instaló otra distribución: los rectángulos ya no son los de esta
+        // hoja. La reconstrucción empezó después de pedir la recarga, así que
+        // ya leyó la versión nueva del archivo.
+        LOG_INFO(Assets, reload.path << ": el atlas se reconstruyó durante la recarga; se descarta");
+        return false;
+    }
+    
+    // Todos los frames de la hoja en el mismo frame de render
+    sf::Clock clock;
+    for (const auto& patch : reload.patches) {
+        if (static_cast<size_t>(patch.page) < m_pages.size()) {
+            Assets::patchTexture(m_pages[patch.page], patch.image, patch.position);
+        }
+    }
+    reload.timing.uploadMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+    Assets::recordLoadTiming(reload.timing);
+    LOG_INFO(Assets, "Recargada " << reload.path << " (" << reload.patches.size() << " frames)");
+    return true;
+}
+
+SpriteAtlas::Layout SpriteAtlas::buildLayout(const std::vector<AssetManifest::Texture>& entries, unsigned int maxFrameHeight) {
+    Layout layout;
+    std::vector<sf::Image> images;
+    std::unordered_map<uint64_t, int> sheetByContent;
+    
+    for (const auto& entry : entries) {
+        if (layout.sheetIndex.count(entry.id)) continue;
+        
+        sf::Clock clock;
+        ScaledSheet loaded;
+        if (!Assets::loadScaledSheet(entry.path, entry.columns, entry.rows, maxFrameHeight, loaded)) {
+            continue;
+        }
+        
+        LoadTiming timing;
+        timing.label = entry.id + " (" + entry.path + ")";
+        timing.decodeMs = clock.getElapsedTime().asMicroseconds() / 1000.0;
+        timing.bytes = static_cast<size_t>(loaded.image.getSize().x) * loaded.image.getSize().y * 4;
+        timing.fromCache = loaded.fromCache;
+        Assets::recordLoadTiming(timing);
+        
+        Sheet sheet;
+        sheet.id = entry.id;
+        sheet.path = entry.path;
+        sheet.columns = loaded.columns;
+        sheet.rows = loaded.rows;
+        sheet.sourceFrameSize = loaded.sourceFrameSize;
+        sheet.frameSize = loaded.frameSize;
+        
+        // Hojas idénticas (p. ej. player_idle y player_forward) comparten frames
+        const sf::Vector2u size = loaded.image.getSize();
+        const uint64_t contentHash = Assets::hashBytes(loaded.image.getPixelsPtr(), static_cast<size_t>(size.x) * size.y * 4,
+                                                       Assets::hashBytes(reinterpret_cast<const uint8_t*>(&size), sizeof(size)));
+        auto same = sheetByContent.find(contentHash);
+        if (same != sheetByContent.end()) {
+            sheet.firstFrame = layout.sheets[same->second].firstFrame;
+            layout.sheetIndex[entry.id] = static_cast<int>(layout.sheets.size());
+            layout.sheets.push_back(sheet);
+            LOG_INFO(Assets, entry.id << " es idéntica a " << layout.sheets[same->second].id);
+            continue;
+        }
+        sheetByContent[contentHash] = static_cast<int>(layout.sheets.size());
+        layout.imageSheets.push_back(static_cast<int>(layout.sheets.size()));
+        
+        sheet.firstFrame = layout.frames.size();
+        layout.frames.resize(layout.frames.size() + static_cast<size_t>(sheet.columns) * sheet.rows);
+        layout.scaled = layout.scaled || sheet.frameSize != sheet.sourceFrameSize;
+        
+        layout.sheetIndex[entry.id] = static_cast<int>(layout.sheets.size());
+        layout.sheets.push_back(sheet);
+        images.push_back(std::move(loaded.image));
+    }
+    
+    pack(layout, images);
+    return layout;
+}
+
+int SpriteAtlas::findSheet(const std::string& id) const {
+    auto it = m_sheetIndex.find(id);
+    return it != m_sheetIndex.end() ? it->second : -1;
+}
+
+const SpriteAtlas::Frame& SpriteAtlas::getFrame(int sheet, unsigned int column, unsigned int row) const {
+    const Sheet& info = m_sheets[sheet];
+    column = std::min(column, info.columns - 1);
+    row = std::min(row, info.rows - 1);
+    return m_frames[info.firstFrame + static_cast<size_t>(row) * info.columns + column];
+}
+
+void SpriteAtlas::pack(Layout& layout, const std::vector<sf::Image>& images) {
+    std::vector<Sheet>& sheets = layout.sheets;
+    std::vector<Frame>& frames = layout.frames;
+    if (frames.empty()) return;
+    
+    const unsigned int pageSize = std::min(MAX_PAGE_SIZE, sf::Texture::getMaximumSize());
+    
+    // Origen de cada frame: hoja e imagen propietarias y rectángulo dentro de
+    // la hoja (las hojas duplicadas no tienen imagen ni frames propios)
+    std::vector<int> frameSheet(frames.size());
+    std::vector<int> frameImage(frames.size());
+    for (size_t i = 0; i < layout.imageSheets.size(); ++i) {
+        const Sheet& sheet = sheets[layout.imageSheets[i]];
+        const size_t count = static_cast<size_t>(sheet.columns) * sheet.rows;
+        std::fill_n(frameSheet.begin() + sheet.firstFrame, count, layout.imageSheets[i]);
+        std::fill_n(frameImage.begin() + sheet.firstFrame, count, static_cast<int>(i));
+    }
+    auto sourceRect = [&](size_t frame) {
+        const Sheet& sheet = sheets[frameSheet[frame]];
+        const unsigned int local = static_cast<unsigned int>(frame - sheet.firstFrame);
+        const sf::Vector2i size(sheet.frameSize);
+        return sf::IntRect({static_cast<int>(local % sheet.columns) * size.x, static_cast<int>(local / sheet.columns) * size.y}, size);
+    };
+    
+    // Estanterías: frames ordenados por alto, de izquierda a derecha y de
+    // arriba a abajo; página nueva cuando la actual se llena
+    std::vector<size_t> order(frames.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return sourceRect(a).size.y > sourceRect(b).size.y;
+    });
+    
+    std::vector<sf::Vector2u> pageExtents;
+    int page = -1;
+    unsigned int cursorX = 0, shelfY = 0, shelfHeight = 0;
+    for (size_t frame : order) {
+        const sf::Vector2i size = sourceRect(frame).size;
+        const unsigned int w = static_cast<unsigned int>(size.x) + PAGE_PADDING;
+        const unsigned int h = static_cast<unsigned int>(size.y) + PAGE_PADDING;
+        if (w > pageSize || h > pageSize) {
+            LOG_INFO(Assets, "Frame de " << size.x << "x" << size.y << " mayor que la página");
+            continue;
+        }
+        
+        if (page >= 0 && cursorX + w > pageSize) {
+            shelfY += shelfHeight;
+            cursorX = 0;
+            shelfHeight = 0;
+        }
+        if (page < 0 || shelfY + h > pageSize) {
+            page++;
+            pageExtents.push_back({0, 0});
+            cursorX = shelfY = shelfHeight = 0;
+        }
+        
+        frames[frame].page = page;
+        frames[frame].rect = sf::IntRect({static_cast<int>(cursorX), static_cast<int>(shelfY)}, size);
+        cursorX += w;
+        shelfHeight = std::max(shelfHeight, h);
+        pageExtents[page].x = std::max(pageExtents[page].x, cursorX);
+        pageExtents[page].y = std::max(pageExtents[page].y, shelfY + shelfHeight);
+    }
+    
+    // Componer las páginas en CPU; la subida a la GPU la hace Assets
+    std::vector<sf::Image>& pageImages = layout.pageImages;
+    for (const auto& extent : pageExtents) {
+        pageImages.emplace_back(extent, sf::Color::Transparent);
+    }
+    for (size_t frame = 0; frame < frames.size(); ++frame) {
+        const Frame& placed = frames[frame];
+        if (placed.rect.size.x == 0) continue;
+        if (!pageImages[placed.page].copy(images[frameImage[frame]], sf::Vector2u(placed.rect.position), sourceRect(frame))) {
+            LOG_ERROR(Assets, "Error copiando frame " << frame);
+        }
+    }
+}
+
+void SpriteBatch::clear() {
+    for (auto& vertices : m_pages) {
+        vertices.clear();
+    }
+}
+
+void SpriteBatch::add(const SpriteAtlas::Frame& frame, const sf::Vector2f (&corners)[4], sf::Color color) {
+    if (static_cast<size_t>(frame.page) >= m_pages.size()) {
+        m_pages.resize(frame.page + 1, sf::VertexArray(sf::PrimitiveType::Triangles));
+    }
+    
+    const sf::Vector2f position(frame.rect.position);
+    const sf::Vector2f size(frame.rect.size);
+    const sf::Vector2f texCoords[4] = {
+        position, position + sf::Vector2f(size.x, 0.f), position + size, position + sf::Vector2f(0.f, size.y)
+    };
+    
+    sf::VertexArray& vertices = m_pages[frame.page];
+    for (int i : {0, 1, 2, 0, 2, 3}) {
+        vertices.append(sf::Vertex{corners[i], color, texCoords[i]});
+    }
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target, const SpriteAtlas& atlas) const {
+    for (size_t page = 0; page < m_pages.size() && page < atlas.getPageCount(); ++page) {
+        if (m_pages[page].getVertexCount() == 0) continue;
+        sf::RenderStates states;
+        states.texture = &atlas.getPage(static_cast<int>(page));
+        target.draw(m_pages[page], states);
+    }
+}
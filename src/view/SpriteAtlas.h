@@ -0,0 +1,151 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "systems/AssetManifest.h"
+#include "systems/Assets.h"
+
+class ThreadPool;
+
+// Atlas de sprites construido al arrancar: corta cada spritesheet del
+// manifiesto en frames (según su rejilla declarada) y
+// los empaqueta por estanterías en una o pocas páginas de textura. Los frames
+// pueden guardarse reducidos (ver Assets::loadScaledSheet) al tamaño con el
+// que se dibujan, en vez del tamaño del PNG. Las vistas
+// dibujan con la página y el rectángulo del frame, sin cambiar de textura, así
+// que todas las entidades de una página caben en un solo draw (SpriteBatch).
+class SpriteAtlas {
+public:
+    // Rejilla de una hoja: frames de sourceFrameSize en columns x rows,
+    // guardados en el atlas a frameSize
+    struct Sheet {
+        std::string id;     // Id del manifiesto
+        std::string path;
+        sf::Vector2u sourceFrameSize;
+        sf::Vector2u frameSize;
+        unsigned int columns = 1;
+        unsigned int rows = 1;
+        size_t firstFrame = 0;
+    };
+    
+    struct Frame {
+        int page = 0;
+        sf::IntRect rect;   // En píxeles de la página
+    };
+    
+    static constexpr unsigned int PAGE_PADDING = 2;  // Evita sangrado entre frames
+    
+    // Carga y empaqueta las hojas; las que no existen se omiten. El tiempo de
+    // carga de cada hoja y de subida de cada página va a Assets::getLoadTimings.
+    // maxFrameHeight: alto máximo de un frame en el atlas (0 = original).
+    // Con frames reducidos las páginas usan filtrado suave y, si se pide, mipmaps.
+    // Con pool la carga y el empaquetado corren en segundo plano y las páginas
+    // se suben poco a poco (Assets::processUploads): hasta isReady() el atlas
+    // está vacío y las vistas usan su placeholder.
+    SpriteAtlas(const std::vector<AssetManifest::Texture>& sheets, unsigned int maxFrameHeight = 0,
+                bool mipmaps = false, ThreadPool* pool = nullptr);
+    
+    // Hilo principal, una vez por frame. Devuelve true si cambió lo que se ve.
+    bool update();
+    bool isReady() const { return m_generation > 0; }
+    // Cambia cada vez que se instala una distribución nueva (los índices de
+    // hoja pueden cambiar): las vistas deben volver a buscar sus hojas
+    uint32_t getGeneration() const { return m_generation; }
+    // Construcción, subida o recarga en curso: hay que seguir llamando a update()
+    bool hasPendingWork() const { return m_building || m_reloadsInFlight > 0; }
+    
+    // Recarga en caliente las hojas que usan path. Si la rejilla y el tamaño de
+    // frame no cambian, solo se reescriben sus frames en las páginas; si no, se
+    // reconstruye el atlas entero en segundo plano y se instala cuando todas
+    // sus páginas están subidas. Devuelve false si ninguna hoja usa path.
+    bool reloadSheet(const std::string& path);
+    
+    // Por id del manifiesto; -1 si la hoja no se cargó
+    int findSheet(const std::string& id) const;
+    const Sheet& getSheet(int sheet) const { return m_sheets[sheet]; }
+    const Frame& getFrame(int sheet, unsigned int column, unsigned int row) const;
+    
+    size_t getPageCount() const { return m_pages.size(); }
+    const sf::Texture& getPage(int page) const { return m_pages[page].get(); }
+
+private:
+    // Resultado de cargar y empaquetar (solo CPU: se puede hacer fuera del hilo principal)
+    struct Layout {
+        std::vector<Sheet> sheets;
+        std::vector<Frame> frames;
+        std::unordered_map<std::string, int> sheetIndex;
+        std::vector<sf::Image> pageImages;
+        std::vector<int> imageSheets;  // Hoja propietaria de cada imagen cargada
+        bool scaled = false;
+    };
+    
+    struct PendingLayout {
+        std::mutex mutex;
+        Layout layout;
+        bool done = false;
+    };
+    
+    // Frames de una hoja recargada, ya recortados y listos para subir
+    struct FramePatch {
+        int page;
+        sf::Vector2u position;
+        sf::Image image;
+    };
+    
+    struct SheetReload {
+        std::string path;
+        bool ok = false;
+        bool needsRebuild = false;  // Cambió la rejilla o el tamaño de frame
+        uint32_t generation = 0;    // Distribución de la que salen page y position
+        std::vector<FramePatch> patches;
+        LoadTiming timing;
+    };
+    
+    struct PendingReloads {
+        std::mutex mutex;
+        std::vector<SheetReload> results;
+    };
+    
+    std::vector<AssetManifest::Texture> m_entries;
+    unsigned int m_maxFrameHeight;
+    ThreadPool* m_pool;
+    
+    std::vector<Sheet> m_sheets;
+    std::vector<Frame> m_frames;
+    std::vector<TextureHandle> m_pages;
+    std::unordered_map<std::string, int> m_sheetIndex;
+    bool m_mipmaps;
+    uint32_t m_generation = 0;
+    
+    // Distribución nueva esperando a que sus páginas terminen de subirse
+    Layout m_staged;
+    std::vector<TextureHandle> m_stagedPages;
+    bool m_hasStaged = false;
+    bool m_building = false;
+    bool m_rebuildQueued = false;
+    std::shared_ptr<PendingLayout> m_pendingLayout;
+    std::shared_ptr<PendingReloads> m_pendingReloads;
+    int m_reloadsInFlight = 0;
+    
+    void startBuild();
+    void adopt(Layout&& layout);
+    void commitStaged();
+    bool applyReload(SheetReload& reload);
+    static Layout buildLayout(const std::vector<AssetManifest::Texture>& entries, unsigned int maxFrameHeight);
+    static void pack(Layout& layout, const std::vector<sf::Image>& images);
+};
+
+// Quads de sprites agrupados por página del atlas: un draw por página
+class SpriteBatch {
+public:
+    void clear();
+    // corners en orden: arriba-izquierda, arriba-derecha, abajo-derecha, abajo-izquierda
+    void add(const SpriteAtlas::Frame& frame, const sf::Vector2f (&corners)[4], sf::Color color = sf::Color::White);
+    void draw(sf::RenderTarget& target, const SpriteAtlas& atlas) const;
+
+private:
+    std::vector<sf::VertexArray> m_pages;
+};
@@ -0,0 +1,91 @@
+#include "view/StatsOverlay.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include "view/PixelFont.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace {
+    // Tiempo de CPU (usuario + sistema) de todo el proceso en segundos. No
+    // std::clock: en MSVC devuelve tiempo real desde el arranque.
+    double processCpuSeconds() {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0.0;
+        auto ticks = [](const FILETIME& time) {
+            return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+        return static_cast<double>(ticks(kernel) + ticks(user)) * 1e-7;  // Unidades de 100 ns
+#else
+        timespec now;
+        if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) != 0) return 0.0;
+        return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_nsec) * 1e-9;
+#endif
+    }
+}
+
+StatsOverlay::StatsOverlay() : m_sampleCpuStart(processCpuSeconds()), m_vertices(sf::PrimitiveType::Triangles) {
+}
+
+void StatsOverlay::onFrame(float frameSeconds) {
+    m_framesInWindow++;
+    m_frameSecondsInWindow += frameSeconds;
+    m_frameHistory[m_historyIndex] = frameSeconds * 1000.f;
+    m_historyIndex = (m_historyIndex + 1) % HISTORY_SIZE;
+    
+    float elapsed = m_sampleClock.getElapsedTime().asSeconds();
+    if (elapsed < SAMPLE_SECONDS) return;
+    
+    // Tiempo de CPU del proceso: 100% = un núcleo ocupado
+    double cpuNow = processCpuSeconds();
+    float cpuSeconds = static_cast<float>(cpuNow - m_sampleCpuStart);
+    
+    m_tickRate = m_ticksInWindow / elapsed;
+    m_renderRate = m_framesInWindow / elapsed;
+    m_frameMs = m_framesInWindow > 0 ? (m_frameSecondsInWindow / m_framesInWindow) * 1000.f : 0.f;
+    m_cpuPercent = cpuSeconds / elapsed * 100.f;
+    
+    m_ticksInWindow = 0;
+    m_framesInWindow = 0;
+    m_frameSecondsInWindow = 0.f;
+    m_sampleCpuStart = cpuNow;
+    m_sampleClock.restart();
+}
+
+void StatsOverlay::draw(sf::RenderTarget& target) {
+    const float pixel = 2.f;
+    const sf::Vector2f origin(8.f, 8.f);
+    const float width = 250.f;
+    const float graphHeight = 40.f;
+    
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "TICK %.0f/S\nFPS %.0f (%.2f MS)\nCPU %.0f%%\nMODO %s",
+                  m_tickRate, m_renderRate, m_frameMs, m_cpuPercent, m_frameModeLabel.c_str());
+    
+    m_vertices.clear();
+    PixelFont::appendRect(m_vertices, origin, {width, 4 * 7 * pixel + graphHeight + 16.f}, sf::Color(0, 0, 0, 170));
+    PixelFont::appendText(m_vertices, buffer, origin + sf::Vector2f(6.f, 6.f), pixel, sf::Color::White);
+    
+    // Gráfica de tiempos de frame: la línea marca 16.7 ms (60 Hz)
+    const sf::Vector2f graphPos(origin.x + 6.f, origin.y + 4 * 7 * pixel + 10.f);
+    const float graphWidth = width - 12.f;
+    const float maxMs = 33.3f;
+    const float barWidth = graphWidth / HISTORY_SIZE;
+    for (int i = 0; i < HISTORY_SIZE; ++i) {
+        float ms = m_frameHistory[(m_historyIndex + i) % HISTORY_SIZE];
+        float h = std::min(ms / maxMs, 1.f) * graphHeight;
+        sf::Color color = ms > 16.7f ? sf::Color(220, 80, 60) : sf::Color(80, 200, 90);
+        PixelFont::appendRect(m_vertices, {graphPos.x + i * barWidth, graphPos.y + graphHeight - h}, {barWidth, h}, color);
+    }
+    float budgetY = graphPos.y + graphHeight - (16.7f / maxMs) * graphHeight;
+    PixelFont::appendRect(m_vertices, {graphPos.x, budgetY}, {graphWidth, 1.f}, sf::Color(255, 255, 0, 160));
+    
+    target.draw(m_vertices);
+}
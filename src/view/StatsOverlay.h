@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// Overlay de rendimiento (F10): ticks de simulación por segundo, frames por
+// segundo, tiempo de frame, uso de CPU del proceso y gráfica de frame times.
+class StatsOverlay {
+public:
+    StatsOverlay();
+    
+    void onTick() { m_ticksInWindow++; }
+    void onFrame(float frameSeconds);
+    void setFrameModeLabel(const std::string& label) { m_frameModeLabel = label; }
+    
+    void draw(sf::RenderTarget& target);
+    
+    float getTickRate() const { return m_tickRate; }
+    float getRenderRate() const { return m_renderRate; }
+    float getCpuPercent() const { return m_cpuPercent; }
+    
+private:
+    static constexpr float SAMPLE_SECONDS = 0.5f;
+    static constexpr int HISTORY_SIZE = 120;
+    
+    sf::Clock m_sampleClock;
+    double m_sampleCpuStart;  // Tiempo de CPU del proceso al empezar la ventana (s)
+    int m_ticksInWindow = 0;
+    int m_framesInWindow = 0;
+    float m_frameSecondsInWindow = 0.f;
+    
+    float m_tickRate = 0.f;
+    float m_renderRate = 0.f;
+    float m_frameMs = 0.f;
+    float m_cpuPercent = 0.f;
+    std::string m_frameModeLabel;
+    
+    float m_frameHistory[HISTORY_SIZE] = {};
+    int m_historyIndex = 0;
+    
+    sf::VertexArray m_vertices;
+};